@@ -0,0 +1,214 @@
+#include "animScheduler.hpp"
+#include "animation.hpp"
+#include "cannon.hpp"
+#include "prayAnimation.hpp"
+#include "flower.hpp"
+#include "meditation.hpp"
+#include <chrono>
+#include <cstdio>
+
+// ---------- system adapters: step once, report whether still running ----------
+static bool stepCannon() {
+    updateCannonAnimation();
+    updateShootingAnimation();
+    return isCannonAnimating();
+}
+
+static bool stepCharacter() {
+    updateAnimations();
+    updateFireWheelParticles(0.016f);
+    updateDragonFireParticles(0.016f);
+    return animState.isAnimating;
+}
+
+static bool stepLegLift() {
+    updateRightLegLiftAnimation();
+    return rightLegLiftAnim.isActive;
+}
+
+static bool stepStraightLeg() {
+    updateRightStraightLegLift();
+    // lowering runs to zero; lifting only needs frames until it reaches the top
+    if (rightLegLiftAnim.straightLegLowering) return true;
+    return rightLegLiftAnim.straightLegLiftActive &&
+        rightLegLiftAnim.straightLegTime < rightLegLiftAnim.straightLegDurationUp;
+}
+
+static bool stepKungFuKick() {
+    updateKungFuKickAnimation();
+    return kungFuKick.isActive;
+}
+
+static bool stepFlowerBloom() {
+    updateFlowerBloomAnimation();
+    return flowerBloom.isActive;
+}
+
+static bool stepMeditation() {
+    updateMeditationAnimation();
+    return meditation.isActive;
+}
+
+// ---------- draw adapters ----------
+static void drawCharacterEffects() {
+    drawFireWheels();
+    drawFireDragon();
+}
+
+static void drawFlowerGround(float x, float y, float z) {
+    drawFlowerBloomAt(x, y + 0.02f, z); // just above the ground slab
+}
+
+static void drawMeditationGround(float x, float y, float z) {
+    drawLotusPlatform(x, y, z);
+    drawMeditationParticles(x, y, z);
+}
+
+struct AnimSystem {
+    const char* name;
+    bool (*step)();
+    void (*drawCharacter)();                       // optional
+    void (*drawGround)(float x, float y, float z);  // optional
+};
+
+static const AnimSystem kSystems[ANIMSYS_COUNT] = {
+    { "cannon",         stepCannon,      nullptr,              nullptr },
+    { "character",      stepCharacter,   drawCharacterEffects, nullptr },
+    { "leg lift",       stepLegLift,     nullptr,              nullptr },
+    { "straight leg",   stepStraightLeg, nullptr,              nullptr },
+    { "kung fu kick",   stepKungFuKick,  nullptr,              drawKungFuKickDust },
+    { "flower bloom",   stepFlowerBloom, nullptr,              drawFlowerGround },
+    { "meditation",     stepMeditation,  nullptr,              drawMeditationGround },
+};
+
+// Active set, kept sorted by id so update order never changes
+static int  gActive[ANIMSYS_COUNT];
+static int  gActiveCount = 0;
+static bool gIsActive[ANIMSYS_COUNT] = {};
+static bool gRetiring[ANIMSYS_COUNT] = {};   // finished this frame, dropped after the pass
+
+// Profiling: accumulated update cost per system
+static double   gUpdateMs[ANIMSYS_COUNT] = {};
+static unsigned gUpdateFrames[ANIMSYS_COUNT] = {};
+
+// Timed cues
+struct AnimCue {
+    void (*fn)() = nullptr;
+    const char* name = nullptr;
+    float delay = 0.0f;
+    float elapsed = 0.0f;
+};
+static const int kMaxCues = 8;
+static AnimCue gCues[kMaxCues];
+static int gCueCount = 0;
+
+void scheduleAnimation(AnimSystemId id) {
+    if (id < 0 || id >= ANIMSYS_COUNT) return;
+    if (gIsActive[id]) { gRetiring[id] = false; return; } // re-triggered: keep it
+    gIsActive[id] = true;
+
+    int i = gActiveCount++;
+    while (i > 0 && gActive[i - 1] > id) { gActive[i] = gActive[i - 1]; --i; }
+    gActive[i] = id;
+}
+
+void cancelAnimationCue(void (*fn)()) {
+    int out = 0;
+    for (int i = 0; i < gCueCount; ++i)
+        if (gCues[i].fn != fn) gCues[out++] = gCues[i];
+    gCueCount = out;
+}
+
+void scheduleAnimationCue(float delay, void (*fn)(), const char* name) {
+    cancelAnimationCue(fn);
+    if (gCueCount >= kMaxCues) {
+        std::printf("Animation scheduler: cue table full, dropping '%s'\n", name);
+        return;
+    }
+    AnimCue& c = gCues[gCueCount++];
+    c.fn = fn;
+    c.name = name;
+    c.delay = delay;
+    c.elapsed = 0.0f;
+}
+
+static void runDueCues() {
+    // copy out first: a cue may schedule another cue
+    void (*due[kMaxCues])();
+    int dueCount = 0;
+
+    int out = 0;
+    for (int i = 0; i < gCueCount; ++i) {
+        gCues[i].elapsed += 0.016f; // ~60 FPS, same clock as the animations
+        if (gCues[i].elapsed >= gCues[i].delay) due[dueCount++] = gCues[i].fn;
+        else gCues[out++] = gCues[i];
+    }
+    gCueCount = out;
+
+    for (int i = 0; i < dueCount; ++i) due[i]();
+}
+
+void updateScheduledAnimations() {
+    typedef std::chrono::steady_clock Clock;
+
+    // iterate a snapshot: a step may trigger (register) another system
+    int frame[ANIMSYS_COUNT];
+    const int count = gActiveCount;
+    for (int i = 0; i < count; ++i) frame[i] = gActive[i];
+
+    for (int i = 0; i < count; ++i) {
+        const int id = frame[i];
+
+        const Clock::time_point t0 = Clock::now();
+        const bool running = kSystems[id].step();
+        gUpdateMs[id] += std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+        ++gUpdateFrames[id];
+
+        if (!running) gRetiring[id] = true;
+    }
+
+    int out = 0;
+    for (int i = 0; i < gActiveCount; ++i) {
+        const int id = gActive[i];
+        if (gRetiring[id]) { gRetiring[id] = false; gIsActive[id] = false; }
+        else gActive[out++] = id;
+    }
+    gActiveCount = out;
+
+    runDueCues();
+}
+
+void drawScheduledCharacterEffects() {
+    for (int i = 0; i < gActiveCount; ++i) {
+        const AnimSystem& s = kSystems[gActive[i]];
+        if (s.drawCharacter) s.drawCharacter();
+    }
+}
+
+void drawScheduledGroundEffects(float x, float y, float z) {
+    for (int i = 0; i < gActiveCount; ++i) {
+        const AnimSystem& s = kSystems[gActive[i]];
+        if (s.drawGround) s.drawGround(x, y, z);
+    }
+}
+
+bool animationsActive() { return gActiveCount > 0 || gCueCount > 0; }
+bool animSystemActive(AnimSystemId id) { return id >= 0 && id < ANIMSYS_COUNT && gIsActive[id]; }
+int  activeAnimSystemCount() { return gActiveCount; }
+const char* animSystemName(AnimSystemId id) { return (id >= 0 && id < ANIMSYS_COUNT) ? kSystems[id].name : "?"; }
+
+void printAnimSchedulerStats() {
+    std::printf("\n=== ANIMATION SCHEDULER ===\n");
+    std::printf("Active systems: %d\n", gActiveCount);
+    for (int i = 0; i < gActiveCount; ++i) std::printf("  - %s\n", kSystems[gActive[i]].name);
+    for (int i = 0; i < gCueCount; ++i)
+        std::printf("  cue '%s' in %.2fs\n", gCues[i].name, gCues[i].delay - gCues[i].elapsed);
+
+    std::printf("Update cost (avg ms per active frame):\n");
+    for (int id = 0; id < ANIMSYS_COUNT; ++id) {
+        if (!gUpdateFrames[id]) continue;
+        std::printf("  %-14s %8.4f  (%u frames)\n", kSystems[id].name,
+            gUpdateMs[id] / gUpdateFrames[id], gUpdateFrames[id]);
+    }
+    std::printf("===========================\n");
+}
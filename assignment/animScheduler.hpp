@@ -0,0 +1,43 @@
+#pragma once
+
+// ---------------- Animation scheduler ----------------
+// Animation systems are registered by their trigger functions and drop out
+// on the frame they report finished, so an idle system costs nothing per
+// frame (no update call, no draw call). Cross-system sequencing (e.g. the
+// fire dragon handing over to the crane pose) is expressed as timed cues
+// instead of function-local statics.
+
+// Systems in update order (matches the old hand-written list in display())
+enum AnimSystemId {
+    ANIMSYS_CANNON = 0,        // barrel swing + charge/beam
+    ANIMSYS_CHARACTER,         // animState: idle / fire wheels / dragon coil / crane
+    ANIMSYS_LEG_LIFT,          // bent right-leg lift
+    ANIMSYS_STRAIGHT_LEG,      // straight right-leg lift / lower
+    ANIMSYS_KUNG_FU_KICK,
+    ANIMSYS_FLOWER_BLOOM,
+    ANIMSYS_MEDITATION,        // pose + lotus platform + particles
+    ANIMSYS_COUNT
+};
+
+// Register a system (no-op if already active). Call from trigger functions.
+void scheduleAnimation(AnimSystemId id);
+
+// Run once after `delay` seconds of animation time unless cancelled first.
+// Scheduling a callback that is already pending restarts its timer.
+void scheduleAnimationCue(float delay, void (*fn)(), const char* name);
+void cancelAnimationCue(void (*fn)());
+
+// Per frame: update every active system, retire finished ones, fire due cues.
+void updateScheduledAnimations();
+
+// Draw the active systems' effects. Character VFX sit in world space next to
+// the character (wheels, dragon); ground effects are placed at (x, y, z).
+void drawScheduledCharacterEffects();
+void drawScheduledGroundEffects(float x, float y, float z);
+
+// Profiling / pacing queries
+bool        animationsActive();                 // any system or cue pending
+bool        animSystemActive(AnimSystemId id);
+int         activeAnimSystemCount();
+const char* animSystemName(AnimSystemId id);
+void        printAnimSchedulerStats();          // active set + update cost
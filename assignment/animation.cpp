@@ -1,6 +1,13 @@
 #include "animation.hpp"
 #include "utils.hpp"
+#include "easing.hpp"
+#include "animScheduler.hpp"
+#include "particles.hpp"
+#include "inputReplay.hpp"
 #include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 
 // Global animation state
 AnimationState animState;
@@ -10,12 +17,13 @@ void updateIdleAnimation();
 void updateFireWheelDashAnimation();
 void updateFireDragonCoilAnimation();
 void updateCranePoseAnimation();  // New function
+static void resetFireWheelParticles();
 
 void updateAnimations() {
     if (!animState.isAnimating) return;
 
-    // Update animation time
-    animState.animTime += 0.016f; // ~60 FPS
+    // Update animation time (a frozen seek re-samples the same moment)
+    if (!animState.timeFrozen) animState.animTime += 0.016f; // ~60 FPS
 
     switch (animState.currentAnim) {
     case ANIM_IDLE:
@@ -101,6 +109,7 @@ void updateFireWheelDashAnimation() {
 void triggerFireWheelDashAnimation() {
     animState.currentAnim = ANIM_FIRE_WHEEL_DASH;
     animState.isAnimating = true;
+    animState.timeFrozen = false;
     animState.animTime = 0.0f;
     animState.animDuration = 4.0f;
     animState.fireWheelHeight = 0.0f;
@@ -108,38 +117,68 @@ void triggerFireWheelDashAnimation() {
     animState.fireWheelScale = 0.0f;
     animState.fireWheelActive = false;
     animState.dragonFade = 1.0f; // Reset dragon fade
+    resetFireWheelParticles();
+    scheduleAnimation(ANIMSYS_CHARACTER);
 }
 void updateFireDragonCoilAnimation() {
-    // Update dragon animation
-    updateDragonHeadAnimation();
-    
-    // After dragon finishes, transition to crane pose
-    static float dragonTime = 0.0f;
-    static bool wasInactive = true;
-    
-    // Reset timer when animation starts
-    if (wasInactive && animState.isAnimating && animState.currentAnim == ANIM_FIRE_DRAGON_COIL) {
-        dragonTime = 0.0f;
-        wasInactive = false;
-    }
-    
-    // Track if animation becomes inactive
-    if (!animState.isAnimating || animState.currentAnim != ANIM_FIRE_DRAGON_COIL) {
-        wasInactive = true;
-        return;
-    }
-    
-    dragonTime += 0.016f;
-    
-    if (dragonTime >= 5.5f) { // After dragon animation completes
-        triggerCranePoseAnimation();
-        dragonTime = 0.0f; // Reset for next time
-    }
+    // Dragon follows the coil clock (the crane pose handoff is a scheduler cue)
+    updateDragonHeadAnimationWithTime(animState.animTime);
 }
 
-// New crane pose animation function
-void updateCranePoseAnimation() {
-    float time = animState.animTime;
+// Cue: after the dragon animation completes, transition to crane pose
+static void handOffDragonToCranePose() {
+    if (!animState.isAnimating || animState.currentAnim != ANIM_FIRE_DRAGON_COIL) return;
+    triggerCranePoseAnimation();
+}
+
+// ---------------- Crane pose channels ----------------
+// Every crane joint angle/offset as one channel array, so each phase is a
+// single batch blend (scaleN) toward kCranePose instead of 24 hand-written lines.
+static float AnimationState::* const kCraneChannels[] = {
+    // pelvis
+    &AnimationState::cranePelvisShift, &AnimationState::cranePelvisYaw, &AnimationState::cranePelvisRoll,
+    // spine / chest
+    &AnimationState::craneSpineExtension, &AnimationState::craneSpineSideBend, &AnimationState::craneChestYaw,
+    // head
+    &AnimationState::craneHeadYaw, &AnimationState::craneHeadPitch,
+    // arms
+    &AnimationState::craneLeftShoulderAbduction, &AnimationState::craneLeftShoulderRotation, &AnimationState::craneLeftElbow,
+    &AnimationState::craneRightShoulderAbduction, &AnimationState::craneRightShoulderRotation, &AnimationState::craneRightElbow,
+    // right leg (stance)
+    &AnimationState::craneRightHipFlexion, &AnimationState::craneRightHipAdduction, &AnimationState::craneRightHipRotation,
+    &AnimationState::craneRightKnee, &AnimationState::craneRightAnkle,
+    // left leg (lifted)
+    &AnimationState::craneLeftHipFlexion, &AnimationState::craneLeftHipAbduction, &AnimationState::craneLeftHipRotation,
+    &AnimationState::craneLeftKnee, &AnimationState::craneLeftAnkle
+};
+static const int kCraneChannelCount = int(sizeof(kCraneChannels) / sizeof(kCraneChannels[0]));
+
+// Full crane pose, same order as kCraneChannels
+static const float kCranePose[kCraneChannelCount] = {
+    0.05f, 10.0f, -5.0f,            // pelvis: 5cm toward stance foot, +10 yaw, -5 roll
+    5.0f, -5.0f, 10.0f,             // spine: +5 extension, -5 side-bend, +10 chest yaw
+    -10.0f, 5.0f,                   // head: yaw back to camera, pitch up
+    -90.0f, 15.0f, 5.0f,            // left arm straight out, external rotation, nearly straight
+    90.0f, 15.0f, 5.0f,             // right arm
+    5.0f, 3.0f, 5.0f, 15.0f, 5.0f,  // right stance leg (soft knee)
+    70.0f, 10.0f, 20.0f, 90.0f, 20.0f // left leg lifted
+};
+enum { CRANE_SPINE_EXTENSION = 3, CRANE_HEAD_PITCH = 7 };
+
+static void writeCraneChannels(AnimationState& anim, const float* v) {
+    for (int i = 0; i < kCraneChannelCount; ++i) anim.*kCraneChannels[i] = v[i];
+}
+
+// Blend every crane channel to kCranePose * weight (0 = neutral, 1 = full pose)
+static void setCranePoseWeight(AnimationState& anim, float weight) {
+    float v[kCraneChannelCount];
+    scaleN(kCranePose, weight, v, kCraneChannelCount);
+    writeCraneChannels(anim, v);
+}
+
+// Pure crane pose sampler: writes the pose at `time` seconds into anim/dragon
+// (no clock of its own, so any moment can be evaluated on any instance)
+void evalCranePoseAt(float time, AnimationState& anim, DragonHeadState& dragon) {
     float flyDuration = 1.0f; // 1 second to fly up
     float transitionDuration = 1.0f; // 1 second to transition into pose
     float holdDuration = 2.5f; // 2.5 seconds to hold the pose
@@ -148,290 +187,150 @@ void updateCranePoseAnimation() {
     if (time < flyDuration) {
         // Phase 1: Fly up gracefully (0-1s)
         float phase = time / flyDuration;
-        animState.craneFlyHeight = phase * 1.5f; // Fly up 1.5 units
-        animState.cranePoseProgress = 0.0f;
-        animState.cranePoseHold = 0.0f;
+        anim.cranePoseProgress = 0.0f;
+        anim.cranePoseHold = 0.0f;
         
         // Smooth flying motion with slight sway
-        float flyPhase = phase * phase * (3.0f - 2.0f * phase); // Ease-in-out
-        animState.craneFlyHeight = flyPhase * 1.5f;
+        anim.craneFlyHeight = smooth01(phase) * 1.5f; // Fly up 1.5 units, ease-in-out
         
         // Add gentle floating motion
-        animState.idleBob = sin(time * 2.0f) * 0.05f; // Gentle floating
-        animState.idleSway = sin(time * 1.5f) * 1.0f; // Gentle swaying while flying
-        
-        // Keep fire particles active during flying
-        dragonHead.isBreathingFire = true;
-        dragonHead.fireIntensity = 1.0f;
-        dragonHead.fireParticleCount = 50.0f;
+        anim.idleBob = sin(time * 2.0f) * 0.05f; // Gentle floating
+        anim.idleSway = sin(time * 1.5f) * 1.0f; // Gentle swaying while flying
         
-        // Reset all pose values during flying
-        animState.cranePelvisShift = 0.0f;
-        animState.cranePelvisYaw = 0.0f;
-        animState.cranePelvisRoll = 0.0f;
-        animState.craneSpineExtension = 0.0f;
-        animState.craneSpineSideBend = 0.0f;
-        animState.craneChestYaw = 0.0f;
-        animState.craneHeadYaw = 0.0f;
-        animState.craneHeadPitch = 0.0f;
+        // Dragon holds its end-of-coil pose (sampled, not carried over)
+        evalDragonHeadAt(DRAGON_FIRE_END, dragon);
         
-        // Reset arm values
-        animState.craneLeftShoulderAbduction = 0.0f;
-        animState.craneLeftShoulderRotation = 0.0f;
-        animState.craneLeftElbow = 0.0f;
-        animState.craneRightShoulderAbduction = 0.0f;
-        animState.craneRightShoulderRotation = 0.0f;
-        animState.craneRightElbow = 0.0f;
+        // Keep fire particles active during flying
+        dragon.isBreathingFire = true;
+        dragon.fireIntensity = 1.0f;
+        dragon.fireParticleCount = 50.0f;
         
-        // Reset leg values
-        animState.craneRightHipFlexion = 0.0f;
-        animState.craneRightHipAdduction = 0.0f;
-        animState.craneRightHipRotation = 0.0f;
-        animState.craneRightKnee = 0.0f;
-        animState.craneRightAnkle = 0.0f;
-        animState.craneLeftHipFlexion = 0.0f;
-        animState.craneLeftHipAbduction = 0.0f;
-        animState.craneLeftHipRotation = 0.0f;
-        animState.craneLeftKnee = 0.0f;
-        animState.craneLeftAnkle = 0.0f;
+        // Neutral pose while flying
+        setCranePoseWeight(anim, 0.0f);
     }
     else if (time < flyDuration + transitionDuration) {
         // Phase 2: Transition into crane pose while floating (1-2s)
         float phase = (time - flyDuration) / transitionDuration;
-        animState.cranePoseProgress = phase;
-        animState.cranePoseHold = 0.0f;
-        animState.craneFlyHeight = 1.5f; // Stay at flying height
+        anim.cranePoseProgress = phase;
+        anim.cranePoseHold = 0.0f;
+        anim.craneFlyHeight = 1.5f; // Stay at flying height
         
-        // Smooth transition using ease-in-out
-        float smoothPhase = phase * phase * (3.0f - 2.0f * phase);
+        // Dragon holds its end-of-coil pose (sampled, not carried over)
+        evalDragonHeadAt(DRAGON_FIRE_END, dragon);
         
         // Keep fire particles active during transition
-        dragonHead.isBreathingFire = true;
-        dragonHead.fireIntensity = 1.0f;
-        dragonHead.fireParticleCount = 50.0f;
-        
-        // Pelvis adjustments
-        animState.cranePelvisShift = smoothPhase * 0.05f; // 3-5cm toward stance foot
-        animState.cranePelvisYaw = smoothPhase * 10.0f; // +10° toward lifted leg
-        animState.cranePelvisRoll = smoothPhase * -5.0f; // -5° roll
+        dragon.isBreathingFire = true;
+        dragon.fireIntensity = 1.0f;
+        dragon.fireParticleCount = 50.0f;
         
-        // Spine adjustments
-        animState.craneSpineExtension = smoothPhase * 5.0f; // +5° extension
-        animState.craneSpineSideBend = smoothPhase * -5.0f; // -5° side-bend toward stance foot
-        animState.craneChestYaw = smoothPhase * 10.0f; // +10° yaw toward lifted leg
-        
-        // Head adjustments
-        animState.craneHeadYaw = smoothPhase * -10.0f; // -10° yaw back to camera
-        animState.craneHeadPitch = smoothPhase * 5.0f; // +5° pitch up
-        
-        // Arm adjustments - straight out to sides
-        animState.craneLeftShoulderAbduction = smoothPhase * -90.0f; // Left arm abduction
-        animState.craneLeftShoulderRotation = smoothPhase * 15.0f; // External rotation
-        animState.craneLeftElbow = smoothPhase * 5.0f; // Nearly straight
-        
-        animState.craneRightShoulderAbduction = smoothPhase * 90.0f; // Right arm abduction
-        animState.craneRightShoulderRotation = smoothPhase * 15.0f; // External rotation
-        animState.craneRightElbow = smoothPhase * 5.0f; // Nearly straight
-        
-        // Leg adjustments - left leg lifted, right leg stance
-        // Right leg (stance)
-        animState.craneRightHipFlexion = smoothPhase * 5.0f; // +5° flexion
-        animState.craneRightHipAdduction = smoothPhase * 3.0f; // +3° adduction
-        animState.craneRightHipRotation = smoothPhase * 5.0f; // +5° external rotation
-        animState.craneRightKnee = smoothPhase * 15.0f; // +15° flexion (soft)
-        animState.craneRightAnkle = smoothPhase * 5.0f; // +5° dorsiflexion
-        
-        // Left leg (lifted)
-        animState.craneLeftHipFlexion = smoothPhase * 70.0f; // +70° flexion
-        animState.craneLeftHipAbduction = smoothPhase * 10.0f; // +10° abduction
-        animState.craneLeftHipRotation = smoothPhase * 20.0f; // +20° external rotation
-        animState.craneLeftKnee = smoothPhase * 90.0f; // +90° flexion
-        animState.craneLeftAnkle = smoothPhase * 20.0f; // +20° plantarflexion
+        // Ease every joint into the pose together
+        setCranePoseWeight(anim, smooth01(phase));
         
         // Continue gentle floating while transitioning
-        animState.idleBob = sin(time * 2.0f) * 0.03f; // Reduced floating
-        animState.idleSway = sin(time * 1.5f) * 0.5f; // Reduced swaying
+        anim.idleBob = sin(time * 2.0f) * 0.03f; // Reduced floating
+        anim.idleSway = sin(time * 1.5f) * 0.5f; // Reduced swaying
     }
     else if (time < flyDuration + transitionDuration + holdDuration) {
         // Phase 3: Hold crane pose while floating (2-4.5s)
         float holdPhase = (time - flyDuration - transitionDuration) / holdDuration;
-        animState.cranePoseProgress = 1.0f;
-        animState.cranePoseHold = holdPhase;
-        animState.craneFlyHeight = 1.5f; // Stay at flying height
+        anim.cranePoseProgress = 1.0f;
+        anim.cranePoseHold = holdPhase;
+        anim.craneFlyHeight = 1.5f; // Stay at flying height
         
         // Add subtle breathing/micro-movements during hold
         float breathPhase = sin(holdPhase * 2.0f * M_PI * 2.0f) * 0.1f; // 2 breath cycles
         
-        // Keep fire particles active during hold with some variation
-        dragonHead.isBreathingFire = true;
-        dragonHead.fireIntensity = 0.8f + 0.2f * sin(time * 3.0f); // Varying intensity
-        dragonHead.fireParticleCount = 40.0f + 10.0f * sin(time * 2.0f); // Varying particle count
-        
-        // Keep all pose values at maximum
-        animState.cranePelvisShift = 0.05f;
-        animState.cranePelvisYaw = 10.0f;
-        animState.cranePelvisRoll = -5.0f;
-        animState.craneSpineExtension = 5.0f + breathPhase;
-        animState.craneSpineSideBend = -5.0f;
-        animState.craneChestYaw = 10.0f;
-        animState.craneHeadYaw = -10.0f;
-        animState.craneHeadPitch = 5.0f + breathPhase * 0.5f;
-        
-        // Arms
-        animState.craneLeftShoulderAbduction = -90.0f;
-        animState.craneLeftShoulderRotation = 15.0f;
-        animState.craneLeftElbow = 5.0f;
-        animState.craneRightShoulderAbduction = 90.0f;
-        animState.craneRightShoulderRotation = 15.0f;
-        animState.craneRightElbow = 5.0f;
+        // Dragon holds its end-of-coil pose (sampled, not carried over)
+        evalDragonHeadAt(DRAGON_FIRE_END, dragon);
         
-        // Legs
-        animState.craneRightHipFlexion = 5.0f;
-        animState.craneRightHipAdduction = 3.0f;
-        animState.craneRightHipRotation = 5.0f;
-        animState.craneRightKnee = 15.0f;
-        animState.craneRightAnkle = 5.0f;
+        // Keep fire particles active during hold with some variation
+        dragon.isBreathingFire = true;
+        dragon.fireIntensity = 0.8f + 0.2f * sin(time * 3.0f); // Varying intensity
+        dragon.fireParticleCount = 40.0f + 10.0f * sin(time * 2.0f); // Varying particle count
         
-        animState.craneLeftHipFlexion = 70.0f;
-        animState.craneLeftHipAbduction = 10.0f;
-        animState.craneLeftHipRotation = 20.0f;
-        animState.craneLeftKnee = 90.0f;
-        animState.craneLeftAnkle = 20.0f;
+        // Full pose, spine and head breathing
+        float v[kCraneChannelCount];
+        std::memcpy(v, kCranePose, sizeof(v));
+        v[CRANE_SPINE_EXTENSION] += breathPhase;
+        v[CRANE_HEAD_PITCH] += breathPhase * 0.5f;
+        writeCraneChannels(anim, v);
         
         // Gentle floating while holding pose
-        animState.idleBob = sin(time * 1.5f) * 0.02f; // Very gentle floating
-        animState.idleSway = sin(time * 1.0f) * 0.3f; // Very gentle swaying
+        anim.idleBob = sin(time * 1.5f) * 0.02f; // Very gentle floating
+        anim.idleSway = sin(time * 1.0f) * 0.3f; // Very gentle swaying
     }
     else if (time < flyDuration + transitionDuration + holdDuration + landDuration) {
         // Phase 4: Gently land and release the pose (4.5-5s)
         float landPhase = (time - flyDuration - transitionDuration - holdDuration) / landDuration;
         
         // Smooth landing with ease-out curve
-        float smoothLandPhase = 1.0f - (1.0f - landPhase) * (1.0f - landPhase); // Ease-out
+        float smoothLandPhase = easeOutQuad(landPhase);
         
         // Gradually descend
-        animState.craneFlyHeight = 1.5f * (1.0f - smoothLandPhase);
+        anim.craneFlyHeight = 1.5f * (1.0f - smoothLandPhase);
         
         // Gradually release the crane pose
         float poseRelease = 1.0f - smoothLandPhase;
-        animState.cranePoseProgress = poseRelease;
-        animState.cranePoseHold = 1.0f - landPhase; // Hold phase decreases
+        anim.cranePoseProgress = poseRelease;
+        anim.cranePoseHold = 1.0f - landPhase; // Hold phase decreases
         
         // Gradually fade out the dragon
-        animState.dragonFade = 1.0f - smoothLandPhase;
+        anim.dragonFade = 1.0f - smoothLandPhase;
         
         // Update dragon animation during landing phase to trigger retraction
         // Map crane pose time (4.5-5s) to dragon retraction time (5.5-6.5s)
-        float dragonTime = 5.5f + (time - 4.5f) * 2.0f; // Scale 0.5s crane time to 1.0s dragon time
-        updateDragonHeadAnimationWithTime(dragonTime);
+        float dragonTime = DRAGON_FIRE_END + (time - 4.5f) * 2.0f; // Scale 0.5s crane time to 1.0s dragon time
+        evalDragonHeadAt(dragonTime, dragon);
         
         // Fire particles fade out during landing
-        dragonHead.isBreathingFire = true;
-        dragonHead.fireIntensity = (1.0f - smoothLandPhase) * 0.8f;
-        dragonHead.fireParticleCount = (1.0f - smoothLandPhase) * 40.0f;
+        dragon.isBreathingFire = true;
+        dragon.fireIntensity = (1.0f - smoothLandPhase) * 0.8f;
+        dragon.fireParticleCount = (1.0f - smoothLandPhase) * 40.0f;
         
         // Smoothly transition all pose values back to neutral
-        // Pelvis adjustments
-        animState.cranePelvisShift = 0.05f * poseRelease;
-        animState.cranePelvisYaw = 10.0f * poseRelease;
-        animState.cranePelvisRoll = -5.0f * poseRelease;
-        
-        // Spine adjustments
-        animState.craneSpineExtension = 5.0f * poseRelease;
-        animState.craneSpineSideBend = -5.0f * poseRelease;
-        animState.craneChestYaw = 10.0f * poseRelease;
-        
-        // Head adjustments
-        animState.craneHeadYaw = -10.0f * poseRelease;
-        animState.craneHeadPitch = 5.0f * poseRelease;
-        
-        // Arm adjustments - gradually return to neutral
-        animState.craneLeftShoulderAbduction = -90.0f * poseRelease;
-        animState.craneLeftShoulderRotation = 15.0f * poseRelease;
-        animState.craneLeftElbow = 5.0f * poseRelease;
-        
-        animState.craneRightShoulderAbduction = 90.0f * poseRelease;
-        animState.craneRightShoulderRotation = 15.0f * poseRelease;
-        animState.craneRightElbow = 5.0f * poseRelease;
-        
-        // Leg adjustments - gradually return to neutral
-        // Right leg (stance)
-        animState.craneRightHipFlexion = 5.0f * poseRelease;
-        animState.craneRightHipAdduction = 3.0f * poseRelease;
-        animState.craneRightHipRotation = 5.0f * poseRelease;
-        animState.craneRightKnee = 15.0f * poseRelease;
-        animState.craneRightAnkle = 5.0f * poseRelease;
-        
-        // Left leg (lifted) - gradually lower
-        animState.craneLeftHipFlexion = 70.0f * poseRelease;
-        animState.craneLeftHipAbduction = 10.0f * poseRelease;
-        animState.craneLeftHipRotation = 20.0f * poseRelease;
-        animState.craneLeftKnee = 90.0f * poseRelease;
-        animState.craneLeftAnkle = 20.0f * poseRelease;
+        setCranePoseWeight(anim, poseRelease);
         
         // Gentle landing motion - reduce floating as we land
-        animState.idleBob = sin(time * 2.0f) * 0.01f * (1.0f - landPhase); // Fade out floating
-        animState.idleSway = sin(time * 1.0f) * 0.1f * (1.0f - landPhase); // Fade out swaying
+        anim.idleBob = sin(time * 2.0f) * 0.01f * (1.0f - landPhase); // Fade out floating
+        anim.idleSway = sin(time * 1.0f) * 0.1f * (1.0f - landPhase); // Fade out swaying
     }
     else {
         // Animation complete - reset everything
-        animState.isAnimating = false;
-        animState.currentAnim = ANIM_NONE;
-        animState.craneFlyHeight = 0.0f;
-        animState.cranePoseProgress = 0.0f;
-        animState.cranePoseHold = 0.0f;
-        animState.dragonFade = 0.0f; // Ensure dragon is fully hidden
+        anim.isAnimating = false;
+        anim.currentAnim = ANIM_NONE;
+        anim.craneFlyHeight = 0.0f;
+        anim.cranePoseProgress = 0.0f;
+        anim.cranePoseHold = 0.0f;
+        anim.dragonFade = 0.0f; // Ensure dragon is fully hidden
         
         // Reset dragon state completely
-        dragonHead.isActive = false;
-        dragonHead.headY = 0.0f;
-        dragonHead.scale = 0.0f;
-        dragonHead.featureSize = 0.0f;
-        dragonHead.hornSize = 0.0f;
-        dragonHead.teethSize = 0.0f;
-        dragonHead.bodyProgress = 0.0f;
-        dragonHead.spiralAngle = 0.0f;
-        dragonHead.bodyScale = 0.0f;
-        dragonHead.isBreathingFire = false;
-        dragonHead.fireIntensity = 0.0f;
-        dragonHead.fireParticleCount = 0.0f;
-        dragonHead.isRetracting = false;
-        dragonHead.retractionProgress = 0.0f;
-        dragonHead.headShrinkProgress = 0.0f;
-        dragonHead.finalHeadScale = 0.0f;
+        dragon.isActive = false;
+        dragon.headY = 0.0f;
+        dragon.scale = 0.0f;
+        dragon.featureSize = 0.0f;
+        dragon.hornSize = 0.0f;
+        dragon.teethSize = 0.0f;
+        dragon.bodyProgress = 0.0f;
+        dragon.spiralAngle = 0.0f;
+        dragon.bodyScale = 0.0f;
+        dragon.isBreathingFire = false;
+        dragon.fireIntensity = 0.0f;
+        dragon.fireParticleCount = 0.0f;
+        dragon.isRetracting = false;
+        dragon.retractionProgress = 0.0f;
+        dragon.headShrinkProgress = 0.0f;
+        dragon.finalHeadScale = 0.0f;
         
         // Reset all crane pose values
-        animState.cranePelvisShift = 0.0f;
-        animState.cranePelvisYaw = 0.0f;
-        animState.cranePelvisRoll = 0.0f;
-        animState.craneSpineExtension = 0.0f;
-        animState.craneSpineSideBend = 0.0f;
-        animState.craneChestYaw = 0.0f;
-        animState.craneHeadYaw = 0.0f;
-        animState.craneHeadPitch = 0.0f;
-        
-        // Reset arm values
-        animState.craneLeftShoulderAbduction = 0.0f;
-        animState.craneLeftShoulderRotation = 0.0f;
-        animState.craneLeftElbow = 0.0f;
-        animState.craneRightShoulderAbduction = 0.0f;
-        animState.craneRightShoulderRotation = 0.0f;
-        animState.craneRightElbow = 0.0f;
-        
-        // Reset leg values
-        animState.craneRightHipFlexion = 0.0f;
-        animState.craneRightHipAdduction = 0.0f;
-        animState.craneRightHipRotation = 0.0f;
-        animState.craneRightKnee = 0.0f;
-        animState.craneRightAnkle = 0.0f;
-        animState.craneLeftHipFlexion = 0.0f;
-        animState.craneLeftHipAbduction = 0.0f;
-        animState.craneLeftHipRotation = 0.0f;
-        animState.craneLeftKnee = 0.0f;
-        animState.craneLeftAnkle = 0.0f;
+        setCranePoseWeight(anim, 0.0f);
     }
 }
 
+// New crane pose animation function
+void updateCranePoseAnimation() {
+    evalCranePoseAt(animState.animTime, animState, dragonHead);
+}
+
 void drawFireDragon() {
     // Call both dragon head and body drawing
     drawDragonHead();
@@ -442,26 +341,32 @@ void drawFireDragon() {
 void triggerIdleAnimation() {
     animState.currentAnim = ANIM_IDLE;
     animState.isAnimating = true;
+    animState.timeFrozen = false;
     animState.animTime = 0.0f;
     animState.animDuration = 0.0f; // Infinite duration
     animState.dragonFade = 1.0f; // Reset dragon fade
     triggerDragonHead();
+    scheduleAnimation(ANIMSYS_CHARACTER);
 }
 
 
 void triggerFireDragonCoilAnimation() {
     animState.currentAnim = ANIM_FIRE_DRAGON_COIL;
     animState.isAnimating = true;
+    animState.timeFrozen = false;
     animState.animTime = 0.0f;
     animState.animDuration = 1.0f;
     animState.dragonFade = 1.0f; // Reset dragon fade
     triggerDragonHead(); // Call the dragon head trigger
+    scheduleAnimation(ANIMSYS_CHARACTER);
+    scheduleAnimationCue(DRAGON_FIRE_END, handOffDragonToCranePose, "dragon -> crane pose");
 }
 
 // New crane pose trigger function
 void triggerCranePoseAnimation() {
     animState.currentAnim = ANIM_CRANE_POSE;
     animState.isAnimating = true;
+    animState.timeFrozen = false;
     animState.animTime = 0.0f;
     animState.animDuration = 5.0f; // 1s fly + 1s transition + 2.5s hold + 0.5s land
     
@@ -470,36 +375,44 @@ void triggerCranePoseAnimation() {
     animState.cranePoseHold = 0.0f;
     animState.craneFlyHeight = 0.0f;
     animState.dragonFade = 1.0f; // Start with dragon fully visible
-    
-    // Reset all crane pose values
-    animState.cranePelvisShift = 0.0f;
-    animState.cranePelvisYaw = 0.0f;
-    animState.cranePelvisRoll = 0.0f;
-    animState.craneSpineExtension = 0.0f;
-    animState.craneSpineSideBend = 0.0f;
-    animState.craneChestYaw = 0.0f;
-    animState.craneHeadYaw = 0.0f;
-    animState.craneHeadPitch = 0.0f;
-    
-    // Reset arm values
-    animState.craneLeftShoulderAbduction = 0.0f;
-    animState.craneLeftShoulderRotation = 0.0f;
-    animState.craneLeftElbow = 0.0f;
-    animState.craneRightShoulderAbduction = 0.0f;
-    animState.craneRightShoulderRotation = 0.0f;
-    animState.craneRightElbow = 0.0f;
-    
-    // Reset leg values
-    animState.craneRightHipFlexion = 0.0f;
-    animState.craneRightHipAdduction = 0.0f;
-    animState.craneRightHipRotation = 0.0f;
-    animState.craneRightKnee = 0.0f;
-    animState.craneRightAnkle = 0.0f;
-    animState.craneLeftHipFlexion = 0.0f;
-    animState.craneLeftHipAbduction = 0.0f;
-    animState.craneLeftHipRotation = 0.0f;
-    animState.craneLeftKnee = 0.0f;
-    animState.craneLeftAnkle = 0.0f;
+    setCranePoseWeight(animState, 0.0f);
+    scheduleAnimation(ANIMSYS_CHARACTER);
+}
+
+// Jump the key-7 sequence (dragon coil, then crane pose) to `t` seconds.
+void seekFireDragonSequence(float t, bool freeze) {
+    if (t < 0.0f) t = 0.0f;
+    if (t < DRAGON_FIRE_END) {
+        triggerFireDragonCoilAnimation();
+        animState.animTime = t;
+        updateFireDragonCoilAnimation();
+        if (freeze) cancelAnimationCue(handOffDragonToCranePose);
+        else scheduleAnimationCue(DRAGON_FIRE_END - t, handOffDragonToCranePose, "dragon -> crane pose");
+    }
+    else {
+        triggerDragonHead();
+        triggerCranePoseAnimation();
+        animState.animTime = t - DRAGON_FIRE_END;
+        updateCranePoseAnimation();
+    }
+    animState.timeFrozen = freeze;
+}
+
+void parseAnimationArgs(int& argc, char** argv) {
+    int out = 1;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--dragon-at") && i + 1 < argc) {
+            const float t = (float)std::atof(argv[++i]);
+            seekFireDragonSequence(t, true);
+            std::printf("Fire dragon sequence frozen at %.2fs (peak fire: %.2f)\n", t, DRAGON_FIRE_END - 0.01f);
+        }
+        else if (!std::strcmp(argv[i], "--fire-density") && i + 1 < argc) {
+            gDragonFireDensity = (float)std::atof(argv[++i]);
+            std::printf("Dragon fire density: %.1fx\n", gDragonFireDensity);
+        }
+        else argv[out++] = argv[i];
+    }
+    argc = out;
 }
 
 void drawFireWheels() {
@@ -533,9 +446,6 @@ void drawFireWheels() {
         glPopMatrix();
     }
     
-    // Draw fire particles around the wheel
-    drawFireWheelParticles(-0.3f, -0.5f, 0.0f);
-    
     glPopMatrix();
 
     // Draw right wheel
@@ -557,64 +467,77 @@ void drawFireWheels() {
         glPopMatrix();
     }
     
-    // Draw fire particles around the wheel
-    drawFireWheelParticles(0.3f, -0.5f, 0.0f);
-    
     glPopMatrix();
+
+    // Sparks for both wheels
+    drawFireWheelParticles();
 }
 
-// Updated function to draw fire particles around the wheels
-void drawFireWheelParticles(float x, float y, float z) {
-    if (!animState.fireWheelActive || animState.fireWheelScale <= 0.0f) return;
-    
-    // Enable blending for fire effect
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    
-    // Disable depth writing for transparency
-    glDepthMask(GL_FALSE);
-    
-    glPushMatrix();
-    glTranslatef(x, y, z);
-    
-    // Set fire material
-    const GLfloat fireAmbient[] = { 0.8f, 0.3f, 0.0f, 0.8f };
-    const GLfloat fireDiffuse[] = { 1.0f, 0.4f, 0.0f, 0.8f };
-    const GLfloat fireSpecular[] = { 1.0f, 0.6f, 0.0f, 0.8f };
-    glMaterialfv(GL_FRONT_AND_BACK, GL_AMBIENT, fireAmbient);
-    glMaterialfv(GL_FRONT_AND_BACK, GL_DIFFUSE, fireDiffuse);
-    glMaterialfv(GL_FRONT_AND_BACK, GL_SPECULAR, fireSpecular);
-    glMaterialf(GL_FRONT_AND_BACK, GL_SHININESS, 32.0f);
-    
-    // Draw fire particles in a circle around the wheel (sideways)
-    int numParticles = 20;
-    float wheelRadius = 0.4f * animState.fireWheelScale;
-    
-    for (int i = 0; i < numParticles; i++) {
-        float angle = (float)i / (float)numParticles * 2.0f * M_PI;
-        float radius = wheelRadius + 0.1f + ((float)rand() / RAND_MAX) * 0.2f; // Random distance from wheel
-        
-        // Random height variation
-        float height = ((float)rand() / RAND_MAX) * 0.3f - 0.15f;
-        
-        // Random size for each particle
-        float particleSize = 0.02f + ((float)rand() / RAND_MAX) * 0.05f;
-        
+// ---------------- Fire-wheel particles ----------------
+// One persistent emitter per wheel, in that wheel's hub frame. Sparks are
+// spawned on a ring round the rim, drift outward, and are carried round by
+// the wheel's spin each step. Seeded from the replay seed so runs repeat.
+static const float kWheelHubX[2] = { -0.3f, 0.3f };   // left, right (under the feet)
+static const float kWheelHubY = -0.5f;
+static ParticleEmitter gWheelSparks[2];
+static float gLastWheelRotation = 0.0f;
+
+static void resetFireWheelParticles() {
+    for (int w = 0; w < 2; ++w)
+        initParticleEmitter(gWheelSparks[w], 128, (uint32_t)gInputReplay.seed * 2654435761u + 0x51u * (w + 1));
+    gLastWheelRotation = animState.fireWheelRotation;
+}
+
+static const float kSparkMinLife = 0.25f, kSparkMaxLife = 0.55f;
+
+void updateFireWheelParticles(float dt) {
+    if (gWheelSparks[0].pool.capacity == 0) resetFireWheelParticles();
+
+    // advect with the wheel: half its spin, so the sparks trail behind the rim
+    const float spinDeg = animState.fireWheelRotation - gLastWheelRotation;
+    gLastWheelRotation = animState.fireWheelRotation;
+
+    const bool emitting = animState.fireWheelActive && animState.fireWheelScale > 0.0f;
+    const float rate = emitting ? 40.0f / (0.5f * (kSparkMinLife + kSparkMaxLife)) : 0.0f; // ~40 alive per wheel
+    const float wheelRadius = 0.4f * animState.fireWheelScale;
+
+    for (int w = 0; w < 2; ++w) {
+        ParticleEmitter& e = gWheelSparks[w];
+        rotateParticlesY(e.pool, deg2rad(spinDeg * 0.5f));
+        stepParticles(e.pool, dt, 0.0f, 0.6f, 0.0f); // hot sparks rise
+
+        const int spawn = emitterSpawnBudget(e, rate, dt);
+        for (int k = 0; k < spawn; ++k)
+            if (!spawnFireWheelSpark(e.pool, wheelRadius)) break;
+    }
+}
+
+bool spawnFireWheelSpark(ParticlePool& pool, float wheelRadius) {
+    ParticleRng& rng = pool.rng;
+    const float angle = rng.range(0.0f, 2.0f * (float)M_PI);
+    const float radius = wheelRadius + 0.1f + rng.range(0.0f, 0.2f);
+    const float ca = std::cos(angle), sa = std::sin(angle);
+
+    ParticleSpawn s;
+    s.x = ca * radius;
+    s.y = rng.range(-0.15f, 0.15f);
+    s.z = sa * radius;
+    s.vx = ca * 0.3f;
+    s.vz = sa * 0.3f;
+    s.life = rng.range(kSparkMinLife, kSparkMaxLife);
+    s.size = rng.range(0.02f, 0.07f);
+    s.r = 1.0f; s.g = rng.range(0.3f, 0.6f); s.b = 0.0f; s.a = 0.8f;
+    return spawnParticle(pool, s);
+}
+
+// One batched draw per wheel, queued for the transparent pass (hub frame,
+// unscaled: spawn radius already follows the wheel scale)
+void drawFireWheelParticles() {
+    for (int w = 0; w < 2; ++w) {
+        if (liveParticleCount(gWheelSparks[w].pool) == 0) continue;
         glPushMatrix();
-        // Position particles in a circle around the wheel (sideways)
-        glTranslatef(cos(angle) * radius, height, sin(angle) * radius);
-        glScalef(particleSize, particleSize, particleSize);
-        
-        // Draw particle as a small sphere
-        glutSolidSphere(1.0f, 8, 6);
-        
+        glTranslatef(kWheelHubX[w], kWheelHubY, 0.0f);
+        queueParticleBillboards(gWheelSparks[w].pool);   // sorted at the hub
         glPopMatrix();
     }
-    
-    // Reset blending
-    glDisable(GL_BLEND);
-    glDepthMask(GL_TRUE);
-    
-    glPopMatrix();
 }
-
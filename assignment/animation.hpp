@@ -21,6 +21,7 @@ struct AnimationState {
     float animTime = 0.0f;
     float animDuration = 0.0f;
     bool isAnimating = false;
+    bool timeFrozen = false;             // seek --dragon-at: re-sample animTime every frame
 
     // Idle animation variables
     float idleSway = 0.0f;
@@ -93,6 +94,16 @@ void triggerIdleAnimation();
 void triggerFireWheelDashAnimation();
 void triggerFireDragonCoilAnimation();
 void triggerCranePoseAnimation();  // New function
+void evalCranePoseAt(float time, AnimationState& anim, DragonHeadState& dragon); // pure sampler
+
+// Seek the key-7 sequence (dragon coil 0-5.5s, then crane pose) to t seconds;
+// freeze keeps re-rendering that exact moment (benchmarks, e.g. peak fire)
+void seekFireDragonSequence(float t, bool freeze);
+// Strips --dragon-at <seconds> / --fire-density <n> from argv and applies them.
+// Call after glutInit().
+void parseAnimationArgs(int& argc, char** argv);
 void drawFireWheels();
-void drawFireWheelParticles(float x, float y, float z);  // New function for fire wheel particles
+void updateFireWheelParticles(float dt);  // sparks simulated in the update phase
+void drawFireWheelParticles();            // batched, one draw per wheel
+bool spawnFireWheelSpark(ParticlePool& pool, float wheelRadius); // hub frame; false when full
 void drawFireDragon();
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "animation.hpp"
 #include "prayAnimation.hpp"
 #include "meditation.hpp"
+#include "textureAtlas.hpp"
 #include <GL/freeglut.h>
 
 // ====== State (from your friend's version) ======
@@ -194,10 +195,11 @@ void drawArmChain(bool left) {
         glDisable(GL_TEXTURE_GEN_S);
         glDisable(GL_TEXTURE_GEN_T);
         glEnable(GL_TEXTURE_2D);
-        glBindTexture(GL_TEXTURE_2D, gTex.pandaBlack);
+        beginAtlasTexture(gTex.pandaBlack);
         glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_REPLACE); // bright fur look
         glScalef(0.85f, 0.75f, 0.85f);
         drawSpherePrim(0.25f, 28, 18);
+        endAtlasTexture();
         glBindTexture(GL_TEXTURE_2D, 0);
         glPopAttrib();
     }
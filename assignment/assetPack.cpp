@@ -0,0 +1,265 @@
+#include "assetPack.hpp"
+#include "mappedFile.hpp"
+#include "mipChain.hpp"
+#include "utils.hpp"        // decodeTextureFile, start/stopGDIplus
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#else
+#include <unistd.h>
+#endif
+
+static const char kMagic[4] = { 'N', 'Z', 'P', 'K' };
+static const uint32_t kVersion = 1;
+static const uint32_t kPageSize = 4096;
+static const int kPackMaxSize = 8192;   // levels above GL_MAX_TEXTURE_SIZE are skipped at upload
+static const char* kDefaultPack = "assets.pack";
+
+enum : uint32_t { PACK_TEXTURE_MIPS = 1 };   // BGRA8 mip chain
+
+// file layout: header, index, then one page-aligned payload per entry
+struct PackHeader {
+    char     magic[4];
+    uint32_t version;
+    uint32_t pageSize;
+    uint32_t entryCount;
+    uint64_t fileBytes;
+};
+
+struct PackEntry {
+    char     name[88];       // relative path, zero-terminated
+    uint32_t kind;
+    uint32_t levelCount;
+    int32_t  width, height;  // level 0
+    uint64_t offset;         // from the start of the file
+    uint64_t bytes;
+};
+
+// ---------- paths ----------
+static std::string gArgv0;
+
+static std::string executableDirectory() {
+    std::string path;
+#if defined(_WIN32)
+    char buf[MAX_PATH];
+    const DWORD n = GetModuleFileNameA(nullptr, buf, MAX_PATH);
+    if (n > 0 && n < MAX_PATH) path.assign(buf, n);
+#else
+    char buf[4096];
+    const ssize_t n = readlink("/proc/self/exe", buf, sizeof(buf));
+    if (n > 0) path.assign(buf, (size_t)n);
+#endif
+    if (path.empty()) path = gArgv0;
+    const size_t slash = path.find_last_of("/\\");
+    return slash == std::string::npos ? std::string() : path.substr(0, slash + 1);
+}
+
+static bool fileExists(const std::string& path) {
+    FILE* f = std::fopen(path.c_str(), "rb");
+    if (f) std::fclose(f);
+    return f != nullptr;
+}
+
+std::string assetPath(const char* relative) {
+    static const std::string dir = executableDirectory();
+    if (!dir.empty()) {
+        const std::string beside = dir + relative;
+        if (fileExists(beside)) return beside;
+    }
+    return relative;
+}
+
+// ---------- packer ----------
+static bool gPackRequested = false;
+static std::string gPackOutput;
+static int gPackExitCode = 0;
+
+void parseAssetPackArgs(int& argc, char** argv) {
+    if (argc > 0) gArgv0 = argv[0];
+    int out = 1;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--pack")) {
+            gPackRequested = true;
+            if (i + 1 < argc && std::strncmp(argv[i + 1], "--", 2) != 0) gPackOutput = argv[++i];
+        }
+        else argv[out++] = argv[i];
+    }
+    argc = out;
+}
+
+int assetPackerExitCode() { return gPackExitCode; }
+
+static uint64_t pageAlign(uint64_t v) { return (v + kPageSize - 1) & ~(uint64_t)(kPageSize - 1); }
+
+static bool writePadding(FILE* f, uint64_t from, uint64_t to) {
+    static const unsigned char kZeros[kPageSize] = {};
+    return to == from || std::fwrite(kZeros, 1, (size_t)(to - from), f) == to - from;
+}
+
+bool runAssetPackerIfRequested(const char* const* files, int count) {
+    if (!gPackRequested) return false;
+    const std::string output = gPackOutput.empty() ? executableDirectory() + kDefaultPack : gPackOutput;
+
+    startGDIplus();
+    std::vector<PackEntry> entries;
+    std::vector<MipChain> chains;
+    std::vector<unsigned char> bgra;
+    gPackExitCode = 0;
+    for (int i = 0; i < count; ++i) {
+        int w = 0, h = 0;
+        if (std::strlen(files[i]) >= sizeof(PackEntry::name)) {
+            std::printf("Pack: name too long, skipping %s\n", files[i]);
+            gPackExitCode = 1;
+            continue;
+        }
+        if (!decodeTextureFile(assetPath(files[i]).c_str(), bgra, w, h)) {
+            std::printf("Pack: can't load %s, skipping\n", files[i]);
+            gPackExitCode = 1;
+            continue;
+        }
+        chains.push_back(MipChain());
+        buildMipChain(bgra.data(), w, h, kPackMaxSize, chains.back());
+
+        PackEntry e;
+        std::memset(&e, 0, sizeof(e));
+        std::strcpy(e.name, files[i]);
+        e.kind = PACK_TEXTURE_MIPS;
+        e.levelCount = (uint32_t)chains.back().levels.size();
+        e.width = chains.back().levels[0].width;
+        e.height = chains.back().levels[0].height;
+        e.bytes = chains.back().texels.size();
+        entries.push_back(e);
+    }
+    stopGDIplus();
+
+    PackHeader h;
+    std::memset(&h, 0, sizeof(h));
+    std::memcpy(h.magic, kMagic, 4);
+    h.version = kVersion;
+    h.pageSize = kPageSize;
+    h.entryCount = (uint32_t)entries.size();
+    const uint64_t indexEnd = sizeof(h) + entries.size() * sizeof(PackEntry);
+    uint64_t offset = pageAlign(indexEnd);
+    for (size_t i = 0; i < entries.size(); ++i) {
+        entries[i].offset = offset;
+        offset = pageAlign(offset + entries[i].bytes);
+    }
+    h.fileBytes = offset;
+
+    // write to a side file and swap it in, so a running copy never maps half a pack
+    const std::string temp = output + ".tmp";
+    FILE* f = std::fopen(temp.c_str(), "wb");
+    bool ok = f != nullptr;
+    if (ok) {
+        ok = std::fwrite(&h, sizeof(h), 1, f) == 1;
+        ok = ok && (entries.empty() || std::fwrite(entries.data(), sizeof(PackEntry), entries.size(), f) == entries.size());
+        uint64_t at = indexEnd;
+        for (size_t i = 0; ok && i < entries.size(); ++i) {
+            ok = writePadding(f, at, entries[i].offset) &&
+                std::fwrite(chains[i].texels.data(), 1, chains[i].texels.size(), f) == chains[i].texels.size();
+            at = entries[i].offset + entries[i].bytes;
+        }
+        ok = ok && writePadding(f, at, h.fileBytes);
+        ok = std::fclose(f) == 0 && ok;
+    }
+    if (ok) {
+        std::remove(output.c_str());   // rename won't replace on Windows
+        ok = std::rename(temp.c_str(), output.c_str()) == 0;
+    }
+    if (!ok) {
+        std::remove(temp.c_str());
+        std::printf("Pack: can't write %s\n", output.c_str());
+        gPackExitCode = 1;
+        return true;
+    }
+    std::printf("Pack: %d of %d textures, %.1f MB -> %s\n", (int)entries.size(), count,
+        h.fileBytes / (1024.0 * 1024.0), output.c_str());
+    return true;
+}
+
+// ---------- reader ----------
+static MappedFile gPack;
+static const PackHeader* gHeader = nullptr;
+static const PackEntry* gEntries = nullptr;
+
+static uint64_t chainBytes(int w, int h, uint32_t levels) {
+    uint64_t total = 0;
+    for (uint32_t i = 0; i < levels; ++i) {
+        total += (uint64_t)w * h * 4;
+        if (w > 1) w >>= 1;
+        if (h > 1) h >>= 1;
+    }
+    return total;
+}
+
+bool openAssetPack(const char* path) {
+    MappedFile f;
+    if (!openMappedFile(f, path)) return false;
+
+    const PackHeader* h = (const PackHeader*)f.data;
+    bool ok = f.size >= sizeof(PackHeader) && std::memcmp(h->magic, kMagic, 4) == 0 &&
+        h->version == kVersion && h->pageSize == kPageSize && h->fileBytes == f.size &&
+        sizeof(PackHeader) + (uint64_t)h->entryCount * sizeof(PackEntry) <= f.size;
+    const PackEntry* e = (const PackEntry*)(f.data + sizeof(PackHeader));
+    for (uint32_t i = 0; ok && i < h->entryCount; ++i) {
+        ok = e[i].name[sizeof(e[i].name) - 1] == 0 && e[i].kind == PACK_TEXTURE_MIPS &&
+            e[i].width > 0 && e[i].height > 0 && e[i].width <= kPackMaxSize && e[i].height <= kPackMaxSize &&
+            e[i].levelCount > 0 && e[i].levelCount <= 32 &&
+            e[i].bytes == chainBytes(e[i].width, e[i].height, e[i].levelCount) &&
+            e[i].offset <= f.size && e[i].bytes <= f.size - e[i].offset;   // no sums that could wrap
+    }
+    if (!ok) {
+        std::printf("Assets: %s isn't a usable pack, using the loose files\n", path);
+        closeMappedFile(f);
+        return false;
+    }
+
+    closeAssetPack();
+    gPack = f;
+    gHeader = h;
+    gEntries = e;
+    std::printf("Assets: %u textures mapped from %s\n", h->entryCount, path);
+    return true;
+}
+
+void closeAssetPack() {
+    closeMappedFile(gPack);
+    gHeader = nullptr;
+    gEntries = nullptr;
+}
+
+bool findPackedTexture(const char* name, PackedTexture& out) {
+    if (!gHeader) return false;
+    for (uint32_t i = 0; i < gHeader->entryCount; ++i) {
+        const PackEntry& e = gEntries[i];
+        if (std::strcmp(e.name, name) != 0) continue;
+        out.width = e.width;
+        out.height = e.height;
+        out.levelCount = (int)e.levelCount;
+        out.texels = gPack.data + e.offset;
+        out.bytes = (size_t)e.bytes;
+        return true;
+    }
+    return false;
+}
+
+void uploadPackedTexture(const PackedTexture& t, int maxSize) {
+    MipLevel levels[32];
+    int count = 0;
+    size_t offset = 0;
+    int w = t.width, h = t.height;
+    for (int i = 0; i < t.levelCount; ++i) {
+        if (w <= maxSize && h <= maxSize) levels[count++] = MipLevel{ w, h, offset };
+        offset += (size_t)w * h * 4;
+        if (w > 1) w >>= 1;
+        if (h > 1) h >>= 1;
+    }
+    uploadMipLevels(levels, count, t.texels);
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include <GL/freeglut.h>
+#include <cstddef>
+#include <string>
+
+// ---------------- Asset pack ----------------
+// One archive ("assets.pack") holding every texture already decoded and
+// mipmapped. A fixed-size header and index come first and each payload
+// starts on a page boundary, so the runtime maps the file and hands
+// pointers straight to glTexImage2D: no reads, no decoding, no parsing
+// beyond a name lookup in the index.
+//
+// `--pack [file]` builds it from the loose files and exits (default: next
+// to the executable). The pack is a snapshot: re-run --pack after editing
+// a texture. Names are the relative paths the code asks for
+// ("textures/gold_belt.bmp"); anything not in the pack, or no pack at all,
+// falls back to the loose file.
+
+// Where an asset lives: next to the executable if it is there, otherwise
+// relative to the working directory (as the loose files always were)
+std::string assetPath(const char* relative);
+
+void parseAssetPackArgs(int& argc, char** argv);
+
+// Returns true when --pack was given and the packer ran (the caller should
+// exit with assetPackerExitCode() instead of starting up).
+bool runAssetPackerIfRequested(const char* const* files, int count);
+int  assetPackerExitCode();
+
+// Map the pack for the rest of the run; false (and nothing changes) when
+// there is none or it isn't a pack this build understands
+bool openAssetPack(const char* path);
+void closeAssetPack();
+
+// A packed texture: its full mip chain (BGRA8, top row first, levels back
+// to back) inside the mapping. Safe to call from any thread once open.
+struct PackedTexture {
+    int width = 0, height = 0;        // level 0
+    int levelCount = 0;
+    const unsigned char* texels = nullptr;
+    size_t bytes = 0;
+};
+bool findPackedTexture(const char* name, PackedTexture& out);
+
+// glTexImage2D the levels into the bound GL_TEXTURE_2D, starting at the
+// first that fits in maxSize (trilinear min filter)
+void uploadPackedTexture(const PackedTexture& t, int maxSize);
@@ -0,0 +1,109 @@
+#include "backgroundDiff.hpp"
+#include "nezha_bg.hpp"
+#include <GL/freeglut.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+// Pass: mean |difference| per channel within kMaxMeanDiff (of 255), and at
+// most kMaxOffShare of the pixels off by more than kOffThreshold anywhere.
+static const double kMaxMeanDiff = 2.0;
+static const double kMaxOffShare = 0.01;
+static const int    kOffThreshold = 24;
+static const float  kTimes[] = { 0.0f, 7.5f, 42.0f, 300.0f };
+static const int    kTimedFrames = 30;
+
+static bool gDiffRequested = false;
+static int  gDiffExitCode = 0;
+
+void parseBackgroundDiffArgs(int& argc, char** argv) {
+    int out = 1;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--bg-diff")) gDiffRequested = true;
+        else argv[out++] = argv[i];
+    }
+    argc = out;
+}
+
+int backgroundDiffExitCode() { return gDiffExitCode; }
+
+static void renderBackdrop(bool shader) {
+    gNezhaBG.shaderMode = shader;
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    drawNezhaBackground();
+    drawNezhaBackdropMountains();
+}
+
+static void readBack(int w, int h, std::vector<unsigned char>& px) {
+    px.resize((size_t)w * h * 4);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadBuffer(GL_BACK);
+    glReadPixels(0, 0, w, h, GL_RGBA, GL_UNSIGNED_BYTE, px.data());
+}
+
+static double msPerFrame(bool shader) {
+    typedef std::chrono::steady_clock Clock;
+    renderBackdrop(shader);   // warm-up: builds programs and caches
+    glFinish();
+    const Clock::time_point t0 = Clock::now();
+    for (int i = 0; i < kTimedFrames; ++i) renderBackdrop(shader);
+    glFinish();
+    return std::chrono::duration<double, std::milli>(Clock::now() - t0).count() / kTimedFrames;
+}
+
+bool runBackgroundDiffIfRequested() {
+    if (!gDiffRequested) return false;
+
+    GLint vp[4];
+    glGetIntegerv(GL_VIEWPORT, vp);
+    const int w = vp[2], h = vp[3];
+
+    const NezhaBGState saved = gNezhaBG;
+    setNezhaEmberCount(0);
+    gNezhaBG.enabled = true;
+    gNezhaBG.cacheStatic = false;   // the reference is the plain geometry path
+
+    std::printf("\n=== BACKGROUND IMAGE DIFF (%dx%d, geometry vs shader) ===\n", w, h);
+    std::printf("%8s %10s %8s %10s\n", "time", "mean diff", "max", "off px");
+
+    bool pass = true;
+    std::vector<unsigned char> ref, shaded;
+    for (float t : kTimes) {
+        gNezhaBG.time = t;
+        renderBackdrop(false);
+        readBack(w, h, ref);
+        renderBackdrop(true);
+        readBack(w, h, shaded);
+
+        double sum = 0.0;
+        int worst = 0;
+        long off = 0;
+        for (size_t i = 0; i < ref.size(); i += 4) {
+            int pixelWorst = 0;
+            for (int c = 0; c < 3; ++c) {
+                const int d = std::abs(ref[i + c] - shaded[i + c]);
+                sum += d;
+                if (d > pixelWorst) pixelWorst = d;
+            }
+            if (pixelWorst > worst) worst = pixelWorst;
+            if (pixelWorst > kOffThreshold) ++off;
+        }
+        const double mean = sum / ((double)w * h * 3);
+        const double offShare = (double)off / ((double)w * h);
+        pass = pass && mean <= kMaxMeanDiff && offShare <= kMaxOffShare;
+        std::printf("%8.1f %10.3f %8d %9.3f%%\n", t, mean, worst, offShare * 100.0);
+    }
+
+    const double geometryMs = msPerFrame(false), shaderMs = msPerFrame(true);
+    std::printf("frame: geometry %.3f ms, shader %.3f ms\n", geometryMs, shaderMs);
+    std::printf("%s (mean <= %.1f, <= %.0f%% of pixels off by > %d)\n",
+        pass ? "PASS" : "FAIL", kMaxMeanDiff, kMaxOffShare * 100.0, kOffThreshold);
+    std::printf("=========================================================\n");
+
+    gNezhaBG = saved;
+    setNezhaEmberCount(saved.emberCount);
+    gDiffExitCode = pass ? 0 : 1;
+    return true;
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+// ---------------- Background image diff ----------------
+// `--bg-diff` renders the backdrop at a few animation times through both
+// the geometry layers and the single fullscreen shader (nezha_bg.hpp),
+// reads both back and compares them, printing the mean and worst channel
+// difference, the share of clearly differing pixels, the frame times and
+// PASS/FAIL against the thresholds below. Embers are left out (they draw
+// the same way in both modes). Runs after the window is up, then exits.
+
+void parseBackgroundDiffArgs(int& argc, char** argv);
+
+// Returns true when the check ran (the caller should exit with
+// backgroundDiffExitCode() instead of entering the main loop).
+bool runBackgroundDiffIfRequested();
+int  backgroundDiffExitCode();
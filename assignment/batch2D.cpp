@@ -0,0 +1,75 @@
+#include "batch2D.hpp"
+#include <vector>
+
+struct Batch2DBuffer {
+    std::vector<float> xy;              // 2 per vertex
+    std::vector<unsigned char> rgba;    // 4 per vertex
+};
+static Batch2DBuffer gBatches[2];       // indexed by TransparentBlend
+
+static inline unsigned char toByte(float c) {
+    if (c <= 0.0f) return 0;
+    if (c >= 1.0f) return 255;
+    return (unsigned char)(c * 255.0f + 0.5f);
+}
+
+static inline void push(Batch2DBuffer& b, const Batch2DVertex& v) {
+    b.xy.push_back(v.x);
+    b.xy.push_back(v.y);
+    b.rgba.push_back(toByte(v.r));
+    b.rgba.push_back(toByte(v.g));
+    b.rgba.push_back(toByte(v.b));
+    b.rgba.push_back(toByte(v.a));
+}
+
+void batch2DFan(TransparentBlend blend, const Batch2DVertex* v, int count) {
+    Batch2DBuffer& b = gBatches[blend];
+    for (int i = 1; i + 1 < count; ++i) {
+        push(b, v[0]);
+        push(b, v[i]);
+        push(b, v[i + 1]);
+    }
+}
+
+void batch2DStrip(TransparentBlend blend, const Batch2DVertex* v, int count) {
+    Batch2DBuffer& b = gBatches[blend];
+    for (int i = 0; i + 2 < count; ++i) {
+        // same winding as GL_TRIANGLE_STRIP (odd triangles swap the first two)
+        const bool odd = (i & 1) != 0;
+        push(b, v[odd ? i + 1 : i]);
+        push(b, v[odd ? i : i + 1]);
+        push(b, v[i + 2]);
+    }
+}
+
+void batch2DQuad(TransparentBlend blend, float x0, float y0, float x1, float y1,
+                 const float bottom[4], const float top[4]) {
+    const Batch2DVertex v[4] = {
+        { x0, y0, bottom[0], bottom[1], bottom[2], bottom[3] },
+        { x1, y0, bottom[0], bottom[1], bottom[2], bottom[3] },
+        { x1, y1, top[0], top[1], top[2], top[3] },
+        { x0, y1, top[0], top[1], top[2], top[3] },
+    };
+    batch2DFan(blend, v, 4);
+}
+
+void batch2DFlush() {
+    glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    for (int mode = BLEND_ALPHA; mode <= BLEND_ADDITIVE; ++mode) {
+        Batch2DBuffer& b = gBatches[mode];
+        const int n = (int)(b.xy.size() / 2);
+        if (n == 0) continue;
+
+        glBlendFunc(GL_SRC_ALPHA, mode == BLEND_ADDITIVE ? GL_ONE : GL_ONE_MINUS_SRC_ALPHA);
+        glVertexPointer(2, GL_FLOAT, 0, b.xy.data());
+        glColorPointer(4, GL_UNSIGNED_BYTE, 0, b.rgba.data());
+        glDrawArrays(GL_TRIANGLES, 0, n);
+
+        b.xy.clear();     // keeps capacity: steady-state frames never allocate
+        b.rgba.clear();
+    }
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glPopClientAttrib();
+}
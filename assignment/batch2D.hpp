@@ -0,0 +1,26 @@
+#pragma once
+#include <GL/freeglut.h>
+#include "transparentPass.hpp"   // TransparentBlend
+
+// ---------------- 2D batcher ----------------
+// Collects coloured 2D triangles for a whole layer (fans and strips are
+// expanded on the CPU, transforms applied by the caller) into one reused
+// vertex buffer per blend mode, and draws each buffer with a single
+// glDrawArrays on flush. Triangles keep their submission order within a
+// blend mode; flush between layers when the order across modes matters.
+// Coordinates are whatever the current projection expects (unit square
+// for the background, pixels for the overlay).
+
+struct Batch2DVertex {
+    float x, y;
+    float r, g, b, a;
+};
+
+void batch2DFan(TransparentBlend blend, const Batch2DVertex* v, int count);    // v[0] is the hub
+void batch2DStrip(TransparentBlend blend, const Batch2DVertex* v, int count);
+void batch2DQuad(TransparentBlend blend, float x0, float y0, float x1, float y1,
+                 const float bottomRGBA[4], const float topRGBA[4]);           // vertical gradient
+
+// Draw everything queued (alpha first, then additive) and empty the batch.
+// Expects blending enabled; sets the blend function per mode.
+void batch2DFlush();
@@ -0,0 +1,133 @@
+#include "bmpLoader.hpp"
+#include "mappedFile.hpp"
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSSE3__) || defined(__AVX__)
+#  include <tmmintrin.h>
+#  define BMP_SSSE3 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  include <emmintrin.h>
+#endif
+#if defined(BMP_SSSE3) || defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define BMP_SSE2 1
+#endif
+
+static const int32_t kMaxSide = 16384;   // keeps w * h * 4 well inside size_t on Win32
+
+static inline uint16_t rd16(const unsigned char* p) { return (uint16_t)(p[0] | (p[1] << 8)); }
+static inline uint32_t rd32(const unsigned char* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+bool parseBmpHeader(const unsigned char* d, size_t size, BmpInfo& info) {
+    if (size < 54 || d[0] != 'B' || d[1] != 'M') return false;
+
+    const uint32_t headerSize = rd32(d + 14);
+    if (headerSize < 40 || 14 + (size_t)headerSize > size) return false;   // no OS/2 core headers
+
+    const int32_t w = (int32_t)rd32(d + 18), h = (int32_t)rd32(d + 22);
+    const int bpp = rd16(d + 28);
+    const uint32_t compression = rd32(d + 30);
+    if (w <= 0 || w > kMaxSide || h == 0 || h < -kMaxSide || h > kMaxSide || rd16(d + 26) != 1) return false;
+    if (bpp != 24 && bpp != 32) return false;
+
+    bool keepAlpha = false;
+    if (compression == 3 && bpp == 32) {                 // BI_BITFIELDS: accept the BGRA layout only
+        if (14 + 40 + 12 > size) return false;
+        if (rd32(d + 54) != 0x00FF0000u || rd32(d + 58) != 0x0000FF00u || rd32(d + 62) != 0x000000FFu)
+            return false;
+        keepAlpha = headerSize >= 56 && rd32(d + 66) == 0xFF000000u;
+    }
+    else if (compression != 0) return false;             // RLE / JPEG / PNG payloads
+
+    info.width = w;
+    info.height = h < 0 ? -h : h;
+    info.bitsPerPixel = bpp;
+    info.topDown = h < 0;
+    info.keepAlpha = keepAlpha;
+    info.pixelOffset = rd32(d + 10);
+    info.rowStride = (((size_t)w * bpp + 31) / 32) * 4;
+    // no sums or products that could wrap
+    return info.pixelOffset <= size && info.rowStride != 0 &&
+        (size_t)info.height <= (size - info.pixelOffset) / info.rowStride;
+}
+
+static void expandRow24(const unsigned char* src, unsigned char* dst, int w) {
+    int x = 0;
+#if defined(BMP_SSSE3)
+    // 4 pixels per step: BGR BGR BGR BGR -> BGRA x4. Reads 16 bytes, so stop
+    // while a full load still fits inside this row's 3*w bytes.
+    const __m128i shuffle = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+    const __m128i alpha = _mm_set1_epi32((int)0xFF000000u);
+    for (; x + 6 <= w; x += 4) {
+        __m128i px = _mm_loadu_si128((const __m128i*)(src + x * 3));
+        _mm_storeu_si128((__m128i*)(dst + x * 4), _mm_or_si128(_mm_shuffle_epi8(px, shuffle), alpha));
+    }
+#elif defined(BMP_SSE2)
+    // No byte shuffle without SSSE3 (MSVC x64 builds land here): slide the
+    // whole load left by 0..3 bytes so pixel i sits in lane i, keep that
+    // lane's three colour bytes from each copy and OR them together.
+    const __m128i lane0 = _mm_setr_epi32(0x00FFFFFF, 0, 0, 0);
+    const __m128i lane1 = _mm_setr_epi32(0, 0x00FFFFFF, 0, 0);
+    const __m128i lane2 = _mm_setr_epi32(0, 0, 0x00FFFFFF, 0);
+    const __m128i lane3 = _mm_setr_epi32(0, 0, 0, 0x00FFFFFF);
+    const __m128i alpha = _mm_set1_epi32((int)0xFF000000u);
+    for (; x + 6 <= w; x += 4) {
+        const __m128i px = _mm_loadu_si128((const __m128i*)(src + x * 3));
+        __m128i out = _mm_or_si128(_mm_and_si128(px, lane0), _mm_and_si128(_mm_slli_si128(px, 1), lane1));
+        out = _mm_or_si128(out, _mm_and_si128(_mm_slli_si128(px, 2), lane2));
+        out = _mm_or_si128(out, _mm_and_si128(_mm_slli_si128(px, 3), lane3));
+        _mm_storeu_si128((__m128i*)(dst + x * 4), _mm_or_si128(out, alpha));
+    }
+#endif
+    for (; x < w; ++x) {
+        dst[x * 4 + 0] = src[x * 3 + 0];
+        dst[x * 4 + 1] = src[x * 3 + 1];
+        dst[x * 4 + 2] = src[x * 3 + 2];
+        dst[x * 4 + 3] = 255;
+    }
+}
+
+static void copyRow32(const unsigned char* src, unsigned char* dst, int w, bool keepAlpha) {
+    if (keepAlpha) { std::memcpy(dst, src, (size_t)w * 4); return; }
+    int x = 0;
+#if defined(BMP_SSE2)
+    const __m128i alpha = _mm_set1_epi32((int)0xFF000000u);
+    for (; x + 4 <= w; x += 4) {
+        __m128i px = _mm_loadu_si128((const __m128i*)(src + x * 4));
+        _mm_storeu_si128((__m128i*)(dst + x * 4), _mm_or_si128(px, alpha));
+    }
+#endif
+    for (; x < w; ++x) {
+        std::memcpy(dst + x * 4, src + x * 4, 3);
+        dst[x * 4 + 3] = 255;
+    }
+}
+
+void decodeBmp(const unsigned char* data, const BmpInfo& info, unsigned char* bgra) {
+    const int w = info.width, h = info.height;
+    for (int y = 0; y < h; ++y) {
+        const int stored = info.topDown ? y : h - 1 - y;   // output is top row first
+        const unsigned char* src = data + info.pixelOffset + info.rowStride * stored;
+        unsigned char* dst = bgra + (size_t)y * w * 4;
+        if (info.bitsPerPixel == 24) expandRow24(src, dst, w);
+        else copyRow32(src, dst, w, info.keepAlpha);
+    }
+}
+
+bool loadBmpFile(const char* path, std::vector<unsigned char>& bgra, int& width, int& height) {
+    MappedFile file;
+    if (!openMappedFile(file, path)) return false;
+
+    BmpInfo info;
+    const bool ok = parseBmpHeader(file.data, file.size, info);
+    if (ok) {
+        bgra.resize((size_t)info.width * info.height * 4);
+        decodeBmp(file.data, info, bgra.data());
+        width = info.width;
+        height = info.height;
+    }
+    closeMappedFile(file);
+    return ok;
+}
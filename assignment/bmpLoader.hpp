@@ -0,0 +1,28 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+// ---------------- Portable BMP decoding ----------------
+// Uncompressed 24- and 32-bit BMPs (BI_RGB, or BI_BITFIELDS with the usual
+// BGRA masks), bottom-up or top-down, decoded straight from the file bytes
+// into a caller-owned BGRA upload buffer. Rows come out top row first, the
+// same order GDI+ LockBits hands over, so textures keep their orientation.
+// 24-bit rows are expanded with an SSSE3 shuffle where available.
+
+struct BmpInfo {
+    int width = 0, height = 0;
+    int bitsPerPixel = 0;
+    bool topDown = false;
+    bool keepAlpha = false;       // 32-bit with an alpha mask; otherwise alpha = 255
+    size_t pixelOffset = 0;       // first stored row
+    size_t rowStride = 0;         // bytes per stored row (4-byte padded)
+};
+
+// Validate the headers; false for anything this decoder doesn't handle.
+bool parseBmpHeader(const unsigned char* data, size_t size, BmpInfo& info);
+
+// Decode into `bgra` (width * height * 4 bytes).
+void decodeBmp(const unsigned char* data, const BmpInfo& info, unsigned char* bgra);
+
+// Map `path`, decode into `bgra` (resized). False if missing or unsupported.
+bool loadBmpFile(const char* path, std::vector<unsigned char>& bgra, int& width, int& height);
@@ -18,6 +18,7 @@
 
 #include "cannon.hpp"
 #include "utils.hpp"        // draw* helpers, PrimitiveCounter, gTex
+#include "animScheduler.hpp"
 #include <cmath>
 #include <cstdio>
 #include <GL/freeglut.h>
@@ -275,38 +276,134 @@ void drawLaserCannonStandalone() {
 }
 
 // ===== Beam FX =====
+// The charge ball, shot and beam body are unit meshes compiled once into
+// display lists and scaled on draw; the beam is a short 16-sided tube whose
+// motion comes from scrolling a banded "energy" texture along its length
+// (texture matrix), not from re-tessellating it every frame.
+static const int kBeamBallSlices = 24, kBeamBallStacks = 16;
+static const int kBeamSides = 16;
+static const float kBeamBandsPerUnit = 0.05f;  // energy bands per unit of beam length
+static const float kBeamScrollSpeed = 3.0f;    // bands per second
+
+static GLuint gBeamBallList = 0;
+static GLuint gBeamBodyList = 0;
+static GLuint gBeamEnergyTex = 0;
+
+// Soft bright bands along t, white across s; modulates the lit accent colour
+static GLuint beamEnergyTexture() {
+    if (gBeamEnergyTex) return gBeamEnergyTex;
+
+    const int N = 64;
+    unsigned char texels[N];
+    for (int i = 0; i < N; ++i) {
+        float t = (float)i / N;
+        float band = 0.5f + 0.5f * cosf(2.0f * (float)M_PI * t);       // one band per repeat
+        float ripple = 0.5f + 0.5f * cosf(6.0f * (float)M_PI * t);     // finer ripples
+        float v = 0.45f + 0.45f * band * band + 0.10f * ripple;
+        texels[i] = (unsigned char)(255.0f * (v > 1.0f ? 1.0f : v));
+    }
+    glGenTextures(1, &gBeamEnergyTex);
+    glBindTexture(GL_TEXTURE_2D, gBeamEnergyTex);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    // rows are one byte wide: read them packed, not on the usual 4-byte stride
+    GLint alignment = 4;
+    glGetIntegerv(GL_UNPACK_ALIGNMENT, &alignment);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_LUMINANCE, 1, N, 0, GL_LUMINANCE, GL_UNSIGNED_BYTE, texels);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, alignment);
+    return gBeamEnergyTex;
+}
+
+static void buildBeamMeshes() {
+    if (gBeamBallList) return;
+
+    gBeamBallList = glGenLists(2);
+    gBeamBodyList = gBeamBallList + 1;
+
+    // unit sphere
+    GLUquadric* q = gluNewQuadric();
+    gluQuadricNormals(q, GLU_SMOOTH);
+    glNewList(gBeamBallList, GL_COMPILE);
+    gluSphere(q, 1.0, kBeamBallSlices, kBeamBallStacks);
+    glEndList();
+    gluDeleteQuadric(q);
+
+    // unit tube along +Z: s runs round the rim, t along the length
+    glNewList(gBeamBodyList, GL_COMPILE);
+    glBegin(GL_QUAD_STRIP);
+    for (int i = 0; i <= kBeamSides; ++i) {
+        float a = 2.0f * (float)M_PI * i / kBeamSides;
+        float c = cosf(a), sn = sinf(a);
+        glNormal3f(c, sn, 0.0f);
+        glTexCoord2f((float)i / kBeamSides, 1.0f); glVertex3f(c, sn, 1.0f);
+        glTexCoord2f((float)i / kBeamSides, 0.0f); glVertex3f(c, sn, 0.0f);
+    }
+    glEnd();
+    glBegin(GL_TRIANGLE_FAN);   // far cap
+    glNormal3f(0.0f, 0.0f, 1.0f);
+    glTexCoord2f(0.5f, 1.0f); glVertex3f(0.0f, 0.0f, 1.0f);
+    for (int i = 0; i <= kBeamSides; ++i) {
+        float a = 2.0f * (float)M_PI * i / kBeamSides;
+        glVertex3f(cosf(a), sinf(a), 1.0f);
+    }
+    glEnd();
+    glEndList();
+}
+
+static void drawBeamBall(float s) {
+    PrimitiveCounter::addPrimitive(GLPrimitive::GLU_SPHERE_PRIM);
+    glPushMatrix();
+    glScalef(s, s, s);
+    glCallList(gBeamBallList);
+    glPopMatrix();
+}
+
 void drawLaserBeam() {
     if (!cannonState.visible) return;
     if (!(cannonState.shootOn || cannonState.powerBall > 0.0f || cannonState.attack > 0.0f))
         return;
 
+    buildBeamMeshes();
     matCannonAccent();
-    glPushMatrix();
 
-    if (cannonState.powerBall > 0.0f) {
-        glPushMatrix();
-        float s = cannonState.powerBall * 0.02f + 0.5f;
-        glScalef(s, s, s);
-        drawSphereWithoutGLU(1.0f, 1.0f, 1.0f, 1.0f);
-        glPopMatrix();
-    }
+    if (cannonState.powerBall > 0.0f)
+        drawBeamBall(cannonState.powerBall * 0.02f + 0.5f);
 
     if (cannonState.attack > 0.0f && cannonState.attackRadius > 0.0f) {
+        const float L = cannonState.attack * 0.01f + 1.0f;
+        const float R = cannonState.attackRadius * 0.5f;
+
+        glPushAttrib(GL_ENABLE_BIT | GL_TEXTURE_BIT);
+        glEnable(GL_TEXTURE_2D);
+        glBindTexture(GL_TEXTURE_2D, beamEnergyTexture());
+        glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+
+        // bands keep a fixed spacing as the beam stretches and flow outwards
+        glMatrixMode(GL_TEXTURE);
         glPushMatrix();
-        float L = cannonState.attack * 0.01f + 1.0f;
-        glScalef(cannonState.attackRadius * 0.5f, cannonState.attackRadius * 0.5f, L);
-        drawCylinderCannon(1.0f, 1.0f, 1.0f);
-        glPopMatrix();
-    }
+        glLoadIdentity();
+        glTranslatef(0.0f, -cannonState.beamScroll, 0.0f);
+        glScalef(1.0f, L * kBeamBandsPerUnit, 1.0f);
+        glMatrixMode(GL_MODELVIEW);
 
-    if (cannonState.shootOn) {
+        countGLQuadStrip(kBeamSides);
+        countGLTriangleFan(kBeamSides + 2);
         glPushMatrix();
-        glScalef(2.0f, 2.0f, 2.0f);
-        drawSphereWithoutGLU(1.0f, 1.0f, 1.0f, 1.0f);
+        glScalef(R, R, L);
+        glCallList(gBeamBodyList);
         glPopMatrix();
+
+        glMatrixMode(GL_TEXTURE);
+        glPopMatrix();
+        glMatrixMode(GL_MODELVIEW);
+        glPopAttrib();
     }
 
-    glPopMatrix();
+    if (cannonState.shootOn)
+        drawBeamBall(2.0f);
 }
 
 // ===== Animation & controls =====
@@ -355,6 +452,10 @@ void updateShootingAnimation() {
 
     // Integrate
     cannonState.attack += cannonState.attackLength;
+    if (cannonState.attack > 0.0f) {
+        cannonState.beamScroll += kBeamScrollSpeed * 0.016f;
+        if (cannonState.beamScroll >= 1.0f) cannonState.beamScroll -= 1.0f;  // texture repeats every 1
+    }
     cannonState.powerBall += cannonState.powerBallSize;
 
     // Clamp
@@ -365,6 +466,7 @@ void updateShootingAnimation() {
 
 void toggleCannon() {
     cannonState.weaponOn = !cannonState.weaponOn;
+    scheduleAnimation(ANIMSYS_CANNON);
     std::printf("Cannon toggled: %s\n", cannonState.weaponOn ? "ON" : "OFF");
 }
 
@@ -381,9 +483,20 @@ void fireCannon() {
         cannonState.shootOn = true; // dev fire
         std::printf("Force firing for debug - shootOn:%d\n", cannonState.shootOn);
     }
+    scheduleAnimation(ANIMSYS_CANNON);
 }
 
 void toggleCannonVisibility() {
     cannonState.visible = !cannonState.visible;
     std::printf("Cannon visibility toggled: %s\n", cannonState.visible ? "ON" : "OFF");
 }
+
+bool isCannonAnimating() {
+    // barrel still swinging toward its rest/raised angle
+    if (!cannonState.weaponOn && cannonState.canonRot < 45.0f) return true;
+    if (cannonState.weaponOn && cannonState.canonRot > 0.0f)   return true;
+
+    // charge, beam or fade-out still in progress
+    return cannonState.shootOn || cannonState.powerBall > 0.0f ||
+        cannonState.attack > 0.0f || cannonState.attackRadius > 0.0f;
+}
@@ -17,6 +17,7 @@ struct CannonState {
     float powerBall = 0.0f;
     float powerBallSize = 0.0f;
     float attackRadius = 0.0f;
+    float beamScroll = 0.0f;       // energy texture offset along the beam, [0, 1)
 
     // Optional sides
     bool  leftShootOn = false;
@@ -41,3 +42,4 @@ void updateShootingAnimation();
 void toggleCannon();
 void fireCannon();
 void toggleCannonVisibility();
+bool isCannonAnimating();          // barrel still rotating or a shot in flight
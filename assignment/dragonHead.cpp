@@ -1,322 +1,108 @@
 #include "dragonHead.hpp"
 #include "utils.hpp"
+#include "particles.hpp"
+#include "inputReplay.hpp"
+#include "textureStreaming.hpp"
+#include <cassert>
 #include <cmath>
+#include <vector>
 #include <GL/freeglut.h>
 
 // Global dragon head state
 DragonHeadState dragonHead;
 
-void updateDragonHeadAnimation() {
-    if (!dragonHead.isActive) return;
+static void clearDragonFire();
 
-    // Simple animation - head appears and features grow in
-    static float animTime = 0.0f;
-    static bool needsReset = false;
+DragonHeadState sampleDragonHead(float animTime, const DragonHeadParams& params) {
+    // Everything not set below stays at its DragonHeadState default (zero / off)
+    DragonHeadState s;
+    s.isActive = true;
 
-    // Reset timer if needed
-    if (needsReset) {
-        animTime = 0.0f;
-        needsReset = false;
-    }
-
-    animTime += 0.016f; // ~60 FPS
+    const float coiledAngle = params.spiralTurns * 2.0f * (float)M_PI;
 
     if (animTime < 1.0f) {
+        // Phase 1: head rises and features grow in
         float phase = animTime / 1.0f;
-        dragonHead.headY = phase * 1.2f;
-        dragonHead.scale = phase * 0.8f;
-        dragonHead.featureSize = phase * 1.2f;
-        dragonHead.hornSize = phase * 1.2f;
-        dragonHead.teethSize = phase * 1.2f;
-
-        dragonHead.bodyProgress = 0.0f;
-        dragonHead.spiralAngle = 0.0f;
-        dragonHead.bodyScale = 0.0f;
-
-        dragonHead.isBreathingFire = false;
-        dragonHead.fireIntensity = 0.0f;
-        dragonHead.fireParticleCount = 0.0f;
-
-        dragonHead.isRetracting = false;
-        dragonHead.retractionProgress = 0.0f;
-        dragonHead.headShrinkProgress = 0.0f;
-        dragonHead.finalHeadScale = 0.0f;
-    }
-    else if (animTime < 2.5f) {
-        float phase2 = (animTime - 1.0f) / 1.5f;
-
-        dragonHead.headY = 1.2f;
-        dragonHead.scale = 0.8f;
-        dragonHead.featureSize = 1.0f;
-        dragonHead.hornSize = 1.0f;
-        dragonHead.teethSize = 1.0f;
-
-        dragonHead.bodyProgress = phase2;
-        dragonHead.spiralAngle = phase2 * 6.0f * (float)M_PI;
-        dragonHead.bodyScale = phase2 * 1.0f;
-
-        dragonHead.isBreathingFire = false;
-        dragonHead.fireIntensity = 0.0f;
-        dragonHead.fireParticleCount = 0.0f;
-
-        dragonHead.isRetracting = false;
-        dragonHead.retractionProgress = 0.0f;
-        dragonHead.headShrinkProgress = 0.0f;
-        dragonHead.finalHeadScale = 0.0f;
+        s.headY = phase * 1.2f;
+        s.scale = phase * 0.8f;
+        s.featureSize = phase * 1.2f;
+        s.hornSize = phase * 1.2f;
+        s.teethSize = phase * 1.2f;
     }
-    else if (animTime < 4.0f) {
-        dragonHead.headY = 1.2f;
-        dragonHead.scale = 0.8f;
-        dragonHead.featureSize = 1.0f;
-        dragonHead.hornSize = 1.0f;
-        dragonHead.teethSize = 1.0f;
-        dragonHead.bodyProgress = 1.0f;
-        dragonHead.spiralAngle = 6.0f * (float)M_PI;
-        dragonHead.bodyScale = 1.0f;
-
-        dragonHead.isBreathingFire = false;
-        dragonHead.fireIntensity = 0.0f;
-        dragonHead.fireParticleCount = 0.0f;
-
-        dragonHead.isRetracting = false;
-        dragonHead.retractionProgress = 0.0f;
-        dragonHead.headShrinkProgress = 0.0f;
-        dragonHead.finalHeadScale = 0.0f;
-    }
-    else if (animTime < 5.5f) {
-        float phase3 = (animTime - 4.0f) / 1.5f;
-
-        dragonHead.headY = 1.2f;
-        dragonHead.scale = 0.8f;
-        dragonHead.featureSize = 1.0f;
-        dragonHead.hornSize = 1.0f;
-        dragonHead.teethSize = 1.0f;
-        dragonHead.bodyProgress = 1.0f;
-        dragonHead.spiralAngle = 6.0f * (float)M_PI;
-        dragonHead.bodyScale = 1.0f;
-
-        dragonHead.isBreathingFire = true;
-        dragonHead.fireIntensity = phase3;
-        dragonHead.fireParticleCount = phase3 * 50.0f;
-
-        dragonHead.isRetracting = false;
-        dragonHead.retractionProgress = 0.0f;
-        dragonHead.headShrinkProgress = 0.0f;
-        dragonHead.finalHeadScale = 0.0f;
+    else if (animTime < DRAGON_FIRE_END) {
+        // Full-size head for the coil, hold and fire phases
+        s.headY = 1.2f;
+        s.scale = 0.8f;
+        s.featureSize = 1.0f;
+        s.hornSize = 1.0f;
+        s.teethSize = 1.0f;
+
+        // Phase 2: body spirals out (1-2.5s), then holds fully coiled
+        float phase2 = (animTime < 2.5f) ? (animTime - 1.0f) / 1.5f : 1.0f;
+        s.bodyProgress = phase2;
+        s.spiralAngle = phase2 * coiledAngle;
+        s.bodyScale = phase2 * 1.0f;
+
+        // Phase 3: fire breathing ramps up (4-5.5s)
+        if (animTime >= 4.0f) {
+            float phase3 = (animTime - 4.0f) / 1.5f;
+            s.isBreathingFire = true;
+            s.fireIntensity = phase3;
+            s.fireParticleCount = phase3 * params.maxFireParticles;
+        }
     }
     else if (animTime < 6.0f) {
-        float retractionPhase = (animTime - 5.5f) / 0.5f;
-
-        dragonHead.isRetracting = true;
-        dragonHead.retractionProgress = retractionPhase;
-        dragonHead.headShrinkProgress = 0.0f;
-
-        dragonHead.headY = 1.2f;
-        dragonHead.scale = 0.8f;
-        dragonHead.featureSize = 1.0f;
-        dragonHead.hornSize = 1.0f;
-        dragonHead.teethSize = 1.0f;
-
-        dragonHead.bodyProgress = 1.0f - retractionPhase;
-        dragonHead.spiralAngle = 6.0f * (float)M_PI * (1.0f - retractionPhase);
-        dragonHead.bodyScale = 1.0f - retractionPhase * 0.5f;
-
-        dragonHead.isBreathingFire = false;
-        dragonHead.fireIntensity = 0.0f;
-        dragonHead.fireParticleCount = 0.0f;
+        // Phase 4: body retracts
+        float retractionPhase = (animTime - DRAGON_FIRE_END) / 0.5f;
+
+        s.isRetracting = true;
+        s.retractionProgress = retractionPhase;
+        s.headShrinkProgress = 0.0f;
+
+        s.headY = 1.2f;
+        s.scale = 0.8f;
+        s.featureSize = 1.0f;
+        s.hornSize = 1.0f;
+        s.teethSize = 1.0f;
+
+        s.bodyProgress = 1.0f - retractionPhase;
+        s.spiralAngle = coiledAngle * (1.0f - retractionPhase);
+        s.bodyScale = 1.0f - retractionPhase * 0.5f;
     }
-    else if (animTime < 6.5f) {
+    else if (animTime < DRAGON_SEQUENCE_END) {
+        // Phase 5: head shrinks away
         float shrinkPhase = (animTime - 6.0f) / 0.5f;
 
-        dragonHead.isRetracting = true;
-        dragonHead.retractionProgress = 1.0f;
-        dragonHead.headShrinkProgress = shrinkPhase;
-
-        dragonHead.headY = 1.2f;
-        dragonHead.finalHeadScale = 0.8f * (1.0f - shrinkPhase);
-        dragonHead.scale = dragonHead.finalHeadScale;
-        dragonHead.featureSize = 1.0f * (1.0f - shrinkPhase);
-        dragonHead.hornSize = 1.0f * (1.0f - shrinkPhase);
-        dragonHead.teethSize = 1.0f * (1.0f - shrinkPhase);
+        s.isRetracting = true;
+        s.retractionProgress = 1.0f;
+        s.headShrinkProgress = shrinkPhase;
 
-        dragonHead.bodyProgress = 0.0f;
-        dragonHead.spiralAngle = 0.0f;
-        dragonHead.bodyScale = 0.0f;
-
-        dragonHead.isBreathingFire = false;
-        dragonHead.fireIntensity = 0.0f;
-        dragonHead.fireParticleCount = 0.0f;
+        s.headY = 1.2f;
+        s.finalHeadScale = 0.8f * (1.0f - shrinkPhase * params.headShrinkFactor);
+        s.scale = s.finalHeadScale;
+        s.featureSize = 1.0f * (1.0f - shrinkPhase);
+        s.hornSize = 1.0f * (1.0f - shrinkPhase);
+        s.teethSize = 1.0f * (1.0f - shrinkPhase);
     }
     else {
-        dragonHead.isActive = false;
-        dragonHead.headY = 0.0f;
-        dragonHead.scale = 0.0f;
-        dragonHead.featureSize = 0.0f;
-        dragonHead.hornSize = 0.0f;
-        dragonHead.teethSize = 0.0f;
-        dragonHead.bodyProgress = 0.0f;
-        dragonHead.spiralAngle = 0.0f;
-        dragonHead.bodyScale = 0.0f;
-        dragonHead.isBreathingFire = false;
-        dragonHead.fireIntensity = 0.0f;
-        dragonHead.fireParticleCount = 0.0f;
-        dragonHead.isRetracting = false;
-        dragonHead.retractionProgress = 0.0f;
-        dragonHead.headShrinkProgress = 0.0f;
-        dragonHead.finalHeadScale = 0.0f;
+        s.isActive = false;
     }
+    return s;
 }
 
-void updateDragonHeadAnimationWithTime(float animTime) {
-    if (!dragonHead.isActive) return;
-
-    if (animTime < 1.0f) {
-        float phase = animTime / 1.0f;
-        dragonHead.headY = phase * 1.2f;
-        dragonHead.scale = phase * 0.8f;
-        dragonHead.featureSize = phase * 1.2f;
-        dragonHead.hornSize = phase * 1.2f;
-        dragonHead.teethSize = phase * 1.2f;
-
-        dragonHead.bodyProgress = 0.0f;
-        dragonHead.spiralAngle = 0.0f;
-        dragonHead.bodyScale = 0.0f;
-
-        dragonHead.isBreathingFire = false;
-        dragonHead.fireIntensity = 0.0f;
-        dragonHead.fireParticleCount = 0.0f;
-
-        dragonHead.isRetracting = false;
-        dragonHead.retractionProgress = 0.0f;
-        dragonHead.headShrinkProgress = 0.0f;
-        dragonHead.finalHeadScale = 0.0f;
-    }
-    else if (animTime < 2.5f) {
-        float phase2 = (animTime - 1.0f) / 1.5f;
-
-        dragonHead.headY = 1.2f;
-        dragonHead.scale = 0.8f;
-        dragonHead.featureSize = 1.0f;
-        dragonHead.hornSize = 1.0f;
-        dragonHead.teethSize = 1.0f;
-
-        dragonHead.bodyProgress = phase2;
-        dragonHead.spiralAngle = phase2 * 6.0f * (float)M_PI;
-        dragonHead.bodyScale = phase2 * 1.0f;
-
-        dragonHead.isBreathingFire = false;
-        dragonHead.fireIntensity = 0.0f;
-        dragonHead.fireParticleCount = 0.0f;
-
-        dragonHead.isRetracting = false;
-        dragonHead.retractionProgress = 0.0f;
-        dragonHead.headShrinkProgress = 0.0f;
-        dragonHead.finalHeadScale = 0.0f;
-    }
-    else if (animTime < 4.0f) {
-        dragonHead.headY = 1.2f;
-        dragonHead.scale = 0.8f;
-        dragonHead.featureSize = 1.0f;
-        dragonHead.hornSize = 1.0f;
-        dragonHead.teethSize = 1.0f;
-        dragonHead.bodyProgress = 1.0f;
-        dragonHead.spiralAngle = 6.0f * (float)M_PI;
-        dragonHead.bodyScale = 1.0f;
-
-        dragonHead.isBreathingFire = false;
-        dragonHead.fireIntensity = 0.0f;
-        dragonHead.fireParticleCount = 0.0f;
-
-        dragonHead.isRetracting = false;
-        dragonHead.retractionProgress = 0.0f;
-        dragonHead.headShrinkProgress = 0.0f;
-        dragonHead.finalHeadScale = 0.0f;
-    }
-    else if (animTime < 5.5f) {
-        float phase3 = (animTime - 4.0f) / 1.5f;
-
-        dragonHead.headY = 1.2f;
-        dragonHead.scale = 0.8f;
-        dragonHead.featureSize = 1.0f;
-        dragonHead.hornSize = 1.0f;
-        dragonHead.teethSize = 1.0f;
-        dragonHead.bodyProgress = 1.0f;
-        dragonHead.spiralAngle = 6.0f * (float)M_PI;
-        dragonHead.bodyScale = 1.0f;
-
-        dragonHead.isBreathingFire = true;
-        dragonHead.fireIntensity = phase3;
-        dragonHead.fireParticleCount = phase3 * 50.0f;
-
-        dragonHead.isRetracting = false;
-        dragonHead.retractionProgress = 0.0f;
-        dragonHead.headShrinkProgress = 0.0f;
-        dragonHead.finalHeadScale = 0.0f;
-    }
-    else if (animTime < 6.0f) {
-        float retractionPhase = (animTime - 5.5f) / 0.5f;
-
-        dragonHead.isRetracting = true;
-        dragonHead.retractionProgress = retractionPhase;
-        dragonHead.headShrinkProgress = 0.0f;
-
-        dragonHead.headY = 1.2f;
-        dragonHead.scale = 0.8f;
-        dragonHead.featureSize = 1.0f;
-        dragonHead.hornSize = 1.0f;
-        dragonHead.teethSize = 1.0f;
-
-        dragonHead.bodyProgress = 1.0f - retractionPhase;
-        dragonHead.spiralAngle = 6.0f * (float)M_PI * (1.0f - retractionPhase);
-        dragonHead.bodyScale = 1.0f - retractionPhase * 0.5f;
+void evalDragonHeadAt(float animTime, DragonHeadState& dragon, const DragonHeadParams& params) {
+    if (!dragon.isActive) return;
 
-        dragonHead.isBreathingFire = false;
-        dragonHead.fireIntensity = 0.0f;
-        dragonHead.fireParticleCount = 0.0f;
-    }
-    else if (animTime < 6.5f) {
-        float shrinkPhase = (animTime - 6.0f) / 0.5f;
-
-        dragonHead.isRetracting = true;
-        dragonHead.retractionProgress = 1.0f;
-        dragonHead.headShrinkProgress = shrinkPhase;
-
-        dragonHead.headY = 1.2f;
-        dragonHead.finalHeadScale = 0.8f * (1.0f - shrinkPhase * 0.95f);
-        dragonHead.scale = dragonHead.finalHeadScale;
-        dragonHead.featureSize = 1.0f * (1.0f - shrinkPhase);
-        dragonHead.hornSize = 1.0f * (1.0f - shrinkPhase);
-        dragonHead.teethSize = 1.0f * (1.0f - shrinkPhase);
-
-        dragonHead.bodyProgress = 0.0f;
-        dragonHead.spiralAngle = 0.0f;
-        dragonHead.bodyScale = 0.0f;
-
-        dragonHead.isBreathingFire = false;
-        dragonHead.fireIntensity = 0.0f;
-        dragonHead.fireParticleCount = 0.0f;
-    }
-    else {
-        dragonHead.isActive = false;
-        dragonHead.headY = 0.0f;
-        dragonHead.scale = 0.0f;
-        dragonHead.featureSize = 0.0f;
-        dragonHead.hornSize = 0.0f;
-        dragonHead.teethSize = 0.0f;
-        dragonHead.bodyProgress = 0.0f;
-        dragonHead.spiralAngle = 0.0f;
-        dragonHead.bodyScale = 0.0f;
-        dragonHead.isBreathingFire = false;
-        dragonHead.fireIntensity = 0.0f;
-        dragonHead.fireParticleCount = 0.0f;
-        dragonHead.isRetracting = false;
-        dragonHead.retractionProgress = 0.0f;
-        dragonHead.headShrinkProgress = 0.0f;
-        dragonHead.finalHeadScale = 0.0f;
-    }
+    const float headTilt = dragon.headTilt; // not animated by the timeline
+    dragon = sampleDragonHead(animTime, params);
+    dragon.headTilt = headTilt;
 }
 
+void updateDragonHeadAnimationWithTime(float animTime, const DragonHeadParams& params) {
+    evalDragonHeadAt(animTime, dragonHead, params);
+}
 void triggerDragonHead() {
+    prefetchTexture(gTex.dragon);   // decodes while the head rises
     dragonHead.isActive = true;
     dragonHead.headY = 0.0f;
     dragonHead.scale = 0.0f;
@@ -332,20 +118,185 @@ void triggerDragonHead() {
     dragonHead.isBreathingFire = false;
     dragonHead.fireIntensity = 0.0f;
     dragonHead.fireParticleCount = 0.0f;
+    clearDragonFire();   // last breath's flames would otherwise reappear frozen
 
     dragonHead.isRetracting = false;
     dragonHead.retractionProgress = 0.0f;
     dragonHead.headShrinkProgress = 0.0f;
     dragonHead.finalHeadScale = 0.0f;
+}
+
+// ---------------- Dragon body: swept tube ----------------
+// The body is one continuous tube swept along the fully coiled spiral.
+// Rings are generated once and cached; as bodyProgress grows the cache is
+// appended to, as it shrinks the draw is trimmed, and the retraction taper
+// only rescales the cached ring offsets (no trig). One glDrawElements call.
+static const int kBodyRings = 129;        // along the spiral (s = i / 128)
+static const int kBodySides = 12;         // around the cross-section
+static const int kRingVerts = kBodySides + 1; // +1: duplicated seam for UVs
+static const float kBodyHeight = 2.8f;
+static const float kBodySpiralRadius = 1.2f;
+static const float kBodyRadius = 0.15f;
+
+struct DragonBodyMesh {
+    float coilAngle = -1.0f;          // curve the cache was built for
+    int   builtRings = 0;             // rings with valid centre/normal data
+    float radiusScale = -1.0f;        // taper the positions were built with
+    int   tubePairs = 0;              // ring pairs covered by the tube indices
+
+    std::vector<float> centre, normal, uv, pos; // per vertex (3, 3, 2, 3)
+    std::vector<float> ringRadius;              // per ring, before taper
+    std::vector<GLuint> indices;                // tube so far, then the two end caps
+};
+static DragonBodyMesh gBody;
+
+static void buildBodyRing(DragonBodyMesh& m, int i) {
+    const float s = (float)i / (float)(kBodyRings - 1);
+    const float a = s * m.coilAngle;
+    const float ca = cosf(a), sa = sinf(a);
+
+    // centreline and its tangent (analytic derivative of the helix)
+    const float cx = ca * kBodySpiralRadius, cy = 1.2f - s * kBodyHeight, cz = sa * kBodySpiralRadius;
+    float tx = -sa * m.coilAngle * kBodySpiralRadius, ty = -kBodyHeight, tz = ca * m.coilAngle * kBodySpiralRadius;
+    const float tl = sqrtf(tx * tx + ty * ty + tz * tz);
+    tx /= tl; ty /= tl; tz /= tl;
+
+    // frame: b1 = T x up, b2 = b1 x T (helix never runs parallel to up)
+    float b1x = -tz, b1y = 0.0f, b1z = tx;
+    const float bl = sqrtf(b1x * b1x + b1z * b1z);
+    b1x /= bl; b1z /= bl;
+    const float b2x = b1y * tz - b1z * ty, b2y = b1z * tx - b1x * tz, b2z = b1x * ty - b1y * tx;
+
+    m.ringRadius[i] = kBodyRadius * (1.0f - s * 0.4f);
+    for (int j = 0; j < kRingVerts; ++j) {
+        const float t = (float)j / (float)kBodySides * 2.0f * (float)M_PI;
+        const float ct = cosf(t), st = sinf(t);
+        const int v = i * kRingVerts + j;
+        m.centre[v * 3 + 0] = cx; m.centre[v * 3 + 1] = cy; m.centre[v * 3 + 2] = cz;
+        m.normal[v * 3 + 0] = ct * b1x + st * b2x;
+        m.normal[v * 3 + 1] = ct * b1y + st * b2y;
+        m.normal[v * 3 + 2] = ct * b1z + st * b2z;
+        m.uv[v * 2 + 0] = (float)j / (float)kBodySides;
+        m.uv[v * 2 + 1] = (float)i * 0.25f;    // texture repeats every 4 rings
+    }
+}
+
+static void placeBodyRing(DragonBodyMesh& m, int i) {
+    const float r = m.ringRadius[i] * m.radiusScale;
+    for (int j = 0; j < kRingVerts; ++j) {
+        const int v = (i * kRingVerts + j) * 3;
+        m.pos[v + 0] = m.centre[v + 0] + m.normal[v + 0] * r;
+        m.pos[v + 1] = m.centre[v + 1] + m.normal[v + 1] * r;
+        m.pos[v + 2] = m.centre[v + 2] + m.normal[v + 2] * r;
+    }
+}
+
+// Closes one end of the tube with a fan to a tip vertex pushed out along the
+// curve by the ring's radius (direction = from ring `inner` to ring `end`)
+static void capBodyEnd(DragonBodyMesh& m, int end, int inner, int tipVertex) {
+    const int ec = end * kRingVerts * 3, ic = inner * kRingVerts * 3;
+    float dx = m.centre[ec + 0] - m.centre[ic + 0];
+    float dy = m.centre[ec + 1] - m.centre[ic + 1];
+    float dz = m.centre[ec + 2] - m.centre[ic + 2];
+    const float dl = sqrtf(dx * dx + dy * dy + dz * dz);
+    if (dl > 0.0f) { dx /= dl; dy /= dl; dz /= dl; }
+
+    const float tip = m.ringRadius[end] * m.radiusScale;
+    m.pos[tipVertex * 3 + 0] = m.centre[ec + 0] + dx * tip;
+    m.pos[tipVertex * 3 + 1] = m.centre[ec + 1] + dy * tip;
+    m.pos[tipVertex * 3 + 2] = m.centre[ec + 2] + dz * tip;
+    m.normal[tipVertex * 3 + 0] = dx; m.normal[tipVertex * 3 + 1] = dy; m.normal[tipVertex * 3 + 2] = dz;
+    m.uv[tipVertex * 2 + 0] = 0.5f; m.uv[tipVertex * 2 + 1] = (float)end * 0.25f;
+
+    // counter-clockwise seen from outside; which way round that is flips
+    // with the direction we look down the tube
+    const bool tail = end > inner;
+    const size_t first = m.indices.size();
+    for (int j = 0; j < kBodySides; ++j) {
+        const GLuint a = end * kRingVerts + j, b = a + 1;
+        m.indices.push_back(tail ? b : a);
+        m.indices.push_back(tail ? a : b);
+        m.indices.push_back(tipVertex);
+    }
+
+#ifndef NDEBUG
+    // the fan's face normal must point out along the curve or the cap is culled
+    const float* p0 = &m.pos[m.indices[first + 0] * 3];
+    const float* p1 = &m.pos[m.indices[first + 1] * 3];
+    const float* p2 = &m.pos[m.indices[first + 2] * 3];
+    const float ux = p1[0] - p0[0], uy = p1[1] - p0[1], uz = p1[2] - p0[2];
+    const float vx = p2[0] - p0[0], vy = p2[1] - p0[1], vz = p2[2] - p0[2];
+    assert((uy * vz - uz * vy) * dx + (uz * vx - ux * vz) * dy + (ux * vy - uy * vx) * dz >= 0.0f);
+#endif
+}
 
-    static bool needsReset = true;
-    (void)needsReset;
+// Bring the cache up to `rings` rings at the given taper; returns index count
+static int updateDragonBodyMesh(DragonBodyMesh& m, int rings, float coilAngle, float radiusScale) {
+    const int tailTip = kBodyRings * kRingVerts; // two spare vertices after the rings
+    const int headTip = tailTip + 1;
+
+    if (m.coilAngle != coilAngle) {
+        const size_t verts = (size_t)headTip + 1;
+        m.centre.assign(verts * 3, 0.0f);
+        m.normal.assign(verts * 3, 0.0f);
+        m.uv.assign(verts * 2, 0.0f);
+        m.pos.assign(verts * 3, 0.0f);
+        m.ringRadius.assign(kBodyRings, 0.0f);
+        m.indices.clear();
+        m.coilAngle = coilAngle;
+        m.builtRings = 0;
+        m.radiusScale = -1.0f;
+        m.tubePairs = 0;
+    }
+
+    // append rings (centre/normal never change for a given curve)
+    const int firstNew = m.builtRings;
+    for (int i = m.builtRings; i < rings; ++i) buildBodyRing(m, i);
+    if (rings > m.builtRings) m.builtRings = rings;
+
+    // taper changed: re-place every built ring, otherwise only the new ones
+    if (m.radiusScale != radiusScale) {
+        m.radiusScale = radiusScale;
+        for (int i = 0; i < m.builtRings; ++i) placeBodyRing(m, i);
+    }
+    else {
+        for (int i = firstNew; i < m.builtRings; ++i) placeBodyRing(m, i);
+    }
+
+    // tube indices: drop last frame's caps, then trim or append ring pairs
+    const int pairs = rings - 1;
+    m.indices.resize((size_t)m.tubePairs * kBodySides * 6);
+    if (pairs < m.tubePairs) {
+        m.indices.resize((size_t)pairs * kBodySides * 6);
+    }
+    else {
+        for (int i = m.tubePairs; i < pairs; ++i) {
+            for (int j = 0; j < kBodySides; ++j) {
+                const GLuint a = i * kRingVerts + j, b = a + 1;
+                const GLuint c = a + kRingVerts, d = c + 1;
+                m.indices.push_back(a); m.indices.push_back(c); m.indices.push_back(b);
+                m.indices.push_back(b); m.indices.push_back(c); m.indices.push_back(d);
+            }
+        }
+    }
+    m.tubePairs = pairs;
+
+    capBodyEnd(m, rings - 1, rings - 2, tailTip);
+    capBodyEnd(m, 0, 1, headTip);
+    return (int)m.indices.size();
 }
 
 // Function to draw the spiraling dragon body
 void drawDragonBody() {
     if (!dragonHead.isActive || dragonHead.bodyProgress <= 0.0f) return;
 
+    const int rings = 1 + (int)(dragonHead.bodyProgress * (kBodyRings - 1));
+    if (rings < 2) return;
+
+    const float coilAngle = DragonHeadParams().spiralTurns * 2.0f * (float)M_PI;
+    const float taper = dragonHead.isRetracting ? (1.0f - dragonHead.retractionProgress * 0.7f) : 1.0f;
+    const int indexCount = updateDragonBodyMesh(gBody, rings, coilAngle, taper);
+
     // Material for specular highlights
     const GLfloat bodyAmb[] = { 0.3f, 0.25f, 0.0f, 1.0f };
     const GLfloat bodyDiff[] = { 0.6f, 0.5f, 0.0f, 1.0f };
@@ -356,44 +307,28 @@ void drawDragonBody() {
     glMaterialf(GL_FRONT_AND_BACK, GL_SHININESS, 16.0f);
 
     glPushAttrib(GL_ENABLE_BIT | GL_TEXTURE_BIT | GL_COLOR_BUFFER_BIT);
+    glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
     glEnable(GL_TEXTURE_2D);
-    glBindTexture(GL_TEXTURE_2D, gTex.dragon);
+    glBindTexture(GL_TEXTURE_2D, useTexture(gTex.dragon));
     glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+    glEnable(GL_NORMALIZE); // body is drawn under a non-unit scale
 
     glPushMatrix();
 
     float globalScale = dragonHead.bodyScale * 1.0f;
     glScalef(globalScale, globalScale, globalScale);
 
-    int   numSegments = 100;
-    float totalHeight = 2.8f;
-    float spiralRadius = 1.2f;
-
-    for (int i = 0; i < numSegments; i++) {
-        float segmentProgress = (float)i / (float)numSegments;
-        if (segmentProgress > dragonHead.bodyProgress) break;
-
-        float height = segmentProgress * totalHeight;
-        float angle = segmentProgress * dragonHead.spiralAngle;
-
-        float x = cosf(angle) * spiralRadius;
-        float z = sinf(angle) * spiralRadius;
-        float y = 1.2f - height;
-
-        glPushMatrix();
-        glTranslatef(x, y, z);
-        glRotatef(angle * 180.0f / (float)M_PI, 0, 1, 0);
-
-        float segmentScale = 1.0f - segmentProgress * 0.4f;
-        if (dragonHead.isRetracting) segmentScale *= (1.0f - dragonHead.retractionProgress * 0.7f);
-        glScalef(segmentScale, segmentScale, segmentScale);
-
-        drawSpherePrim(0.15f, 16, 12);
-
-        glPopMatrix();
-    }
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_NORMAL_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    glVertexPointer(3, GL_FLOAT, 0, gBody.pos.data());
+    glNormalPointer(GL_FLOAT, 0, gBody.normal.data());
+    glTexCoordPointer(2, GL_FLOAT, 0, gBody.uv.data());
+    glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, gBody.indices.data());
+    countGLTriangles(indexCount / 3);
 
     glPopMatrix();
+    glPopClientAttrib();
     glPopAttrib();
 }
 
@@ -463,7 +398,7 @@ void drawDragonHead() {
     // Enable dragon skin texture for head parts
     glPushAttrib(GL_ENABLE_BIT | GL_TEXTURE_BIT);
     glEnable(GL_TEXTURE_2D);
-    glBindTexture(GL_TEXTURE_2D, gTex.dragon);
+    glBindTexture(GL_TEXTURE_2D, useTexture(gTex.dragon));
     glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
 
     // 1) Long snout
@@ -538,12 +473,61 @@ void drawDragonHead() {
     glPopMatrix(); // end head transform
 }
 
-void drawFireParticles() {
-    if (!dragonHead.isActive || !dragonHead.isBreathingFire || dragonHead.fireParticleCount <= 0.0f) return;
+// ---------------- Fire breath particles ----------------
+// Simulated in the mouth's local frame (so the stream follows the head) with
+// real lifetimes: each particle travels out along +Z and fades as it ages.
+float gDragonFireDensity = 6.0f;
+
+static ParticleEmitter gFire;
+
+static const float kFireMinLife = 0.35f, kFireMaxLife = 0.60f;
 
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glDepthMask(GL_FALSE);
+static void clearDragonFire() { clearParticles(gFire.pool); }
+
+void updateDragonFireParticles(float dt) {
+    const bool breathing = dragonHead.isActive && dragonHead.isBreathingFire &&
+        dragonHead.fireParticleCount > 0.0f;
+
+    // pool sized once for the densest breath the current setting can ask for
+    const int needed = (int)(DragonHeadParams().maxFireParticles * gDragonFireDensity * 1.5f) + 16;
+    if (gFire.pool.capacity < needed)
+        initParticleEmitter(gFire, needed, (uint32_t)gInputReplay.seed ^ 0xF12Eu);
+
+    // head gone: drop whatever is still burning
+    if (!dragonHead.isActive) {
+        clearDragonFire();
+        return;
+    }
+    stepParticles(gFire.pool, dt);
+
+    // spawn rate that keeps (fireParticleCount * density) alive on average
+    const float target = breathing ? dragonHead.fireParticleCount * gDragonFireDensity : 0.0f;
+    const int spawn = emitterSpawnBudget(gFire, target / (0.5f * (kFireMinLife + kFireMaxLife)), dt);
+
+    const float reach = 2.0f * dragonHead.fireIntensity + 0.1f; // flame length
+    for (int k = 0; k < spawn; ++k)
+        if (!spawnDragonFireParticle(gFire.pool, reach)) break;
+}
+
+bool spawnDragonFireParticle(ParticlePool& pool, float reach) {
+    ParticleRng& rng = pool.rng;
+    ParticleSpawn s;
+    s.x = rng.range(-0.15f, 0.15f);
+    s.y = rng.range(-0.10f, 0.10f);
+    s.life = rng.range(kFireMinLife, kFireMaxLife);
+    s.vx = rng.range(-0.2f, 0.2f);
+    s.vy = rng.range(-0.1f, 0.2f);
+    s.vz = reach / s.life;
+    s.size = rng.range(0.04f, 0.09f);
+    s.growth = 0.12f;
+    s.r = 1.0f; s.g = rng.range(0.25f, 0.65f); s.b = 0.0f; s.a = 0.85f;
+    return spawnParticle(pool, s);
+}
+
+int dragonFireParticleCount() { return liveParticleCount(gFire.pool); }
+
+void drawFireParticles() {
+    if (!dragonHead.isActive || liveParticleCount(gFire.pool) == 0) return;
 
     glPushMatrix();
     glTranslatef(0.0f, dragonHead.headY, 1.5f);
@@ -551,32 +535,7 @@ void drawFireParticles() {
     glScalef(globalScale, globalScale, globalScale);
     glTranslatef(0.0f, -0.1f, 1.8f); // mouth
 
-    int numParticles = (int)dragonHead.fireParticleCount;
-
-    for (int i = 0; i < numParticles; i++) {
-        float randomX = ((float)rand() / RAND_MAX - 0.5f) * 0.3f;
-        float randomY = ((float)rand() / RAND_MAX - 0.5f) * 0.2f;
-        float randomZ = ((float)rand() / RAND_MAX) * 2.0f * dragonHead.fireIntensity;
-        float particleSize = 0.05f + ((float)rand() / RAND_MAX) * 0.1f;
-
-        glPushMatrix();
-        glTranslatef(randomX, randomY, randomZ);
-        glScalef(particleSize, particleSize, particleSize);
-
-        const GLfloat fireAmb[] = { 0.8f, 0.3f, 0.0f, 0.8f };
-        const GLfloat fireDiff[] = { 1.0f, 0.4f, 0.0f, 0.8f };
-        const GLfloat fireSpec[] = { 1.0f, 0.6f, 0.0f, 0.8f };
-        glMaterialfv(GL_FRONT_AND_BACK, GL_AMBIENT, fireAmb);
-        glMaterialfv(GL_FRONT_AND_BACK, GL_DIFFUSE, fireDiff);
-        glMaterialfv(GL_FRONT_AND_BACK, GL_SPECULAR, fireSpec);
-        glMaterialf(GL_FRONT_AND_BACK, GL_SHININESS, 32.0f);
-
-        drawSpherePrim(1.0f, 10, 8);
-        glPopMatrix();
-    }
+    queueParticleBillboards(gFire.pool, 0.0f, 0.0f, 1.0f);   // sorted at mid-flame
 
     glPopMatrix();
-
-    glDepthMask(GL_TRUE);
-    glDisable(GL_BLEND);
 }
@@ -1,6 +1,8 @@
 #pragma once
 #include <GL/freeglut.h>
 
+struct ParticlePool;
+
 // Dragon head state structure
 struct DragonHeadState {
     bool isActive = false;
@@ -31,11 +33,34 @@ struct DragonHeadState {
 // Global dragon head state
 extern DragonHeadState dragonHead;
 
+// Dragon timeline (seconds): grow 0-1, coil 1-2.5, hold 2.5-4,
+// breathe fire 4-5.5, retract 5.5-6, head shrinks 6-6.5
+#define DRAGON_FIRE_END      5.5f   // fire at full intensity just before this
+#define DRAGON_SEQUENCE_END  6.5f
+
+// Tunables for one dragon instance; the defaults are the key-7 dragon
+struct DragonHeadParams {
+    float spiralTurns = 3.0f;         // body turns when fully coiled
+    float maxFireParticles = 50.0f;   // particle count at peak fire
+    float headShrinkFactor = 0.95f;   // final head scale = 0.8 * (1 - factor)
+};
+
 // Dragon head functions
 void drawDragonHead();
-void updateDragonHeadAnimation();
-void updateDragonHeadAnimationWithTime(float animTime); // New function with time parameter
+// Pure sampler: the dragon state `animTime` seconds into its sequence.
+// No hidden clock, so any moment can be evaluated directly and repeatedly.
+DragonHeadState sampleDragonHead(float animTime, const DragonHeadParams& params = DragonHeadParams());
+// Same, applied in place to an active instance (keeps headTilt; no-op once inactive)
+void evalDragonHeadAt(float animTime, DragonHeadState& dragon, const DragonHeadParams& params = DragonHeadParams());
+void updateDragonHeadAnimationWithTime(float animTime, const DragonHeadParams& params = DragonHeadParams());
 void triggerDragonHead();
-void resetDragonHeadAnimation(); // New function to reset animation timer
 void drawDragonBody();
-void drawFireParticles();  // New function for drawing fire particles
\ No newline at end of file
+void drawFireParticles();  // New function for drawing fire particles
+
+// Fire breath: pooled particles simulated in the update phase
+extern float gDragonFireDensity;            // live particles per unit of fireParticleCount
+void updateDragonFireParticles(float dt);
+int  dragonFireParticleCount();
+// One breath particle in the mouth frame, flame length `reach` (also used by
+// the particle stress mode). False when the pool is full.
+bool spawnDragonFireParticle(ParticlePool& pool, float reach);
\ No newline at end of file
@@ -0,0 +1,48 @@
+#include "easing.hpp"
+
+// Pick the widest vector unit the compiler was told it may use.
+// MSVC x64 always has SSE2; AVX needs /arch:AVX (defines __AVX__).
+#if defined(__AVX__)
+#  include <immintrin.h>
+#  define EASE_AVX 1
+#endif
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#  include <xmmintrin.h>
+#  define EASE_SSE 1
+#endif
+
+void lerpN(const float* a, const float* b, float t, float* out, int n) {
+    int i = 0;
+#if defined(EASE_AVX)
+    const __m256 t8 = _mm256_set1_ps(t);
+    for (; i + 8 <= n; i += 8) {
+        __m256 va = _mm256_loadu_ps(a + i);
+        __m256 vb = _mm256_loadu_ps(b + i);
+        _mm256_storeu_ps(out + i, _mm256_add_ps(va, _mm256_mul_ps(_mm256_sub_ps(vb, va), t8)));
+    }
+#endif
+#if defined(EASE_SSE)
+    const __m128 t4 = _mm_set1_ps(t);
+    for (; i + 4 <= n; i += 4) {
+        __m128 va = _mm_loadu_ps(a + i);
+        __m128 vb = _mm_loadu_ps(b + i);
+        _mm_storeu_ps(out + i, _mm_add_ps(va, _mm_mul_ps(_mm_sub_ps(vb, va), t4)));
+    }
+#endif
+    for (; i < n; ++i) out[i] = lerpf(a[i], b[i], t);
+}
+
+void scaleN(const float* a, float s, float* out, int n) {
+    int i = 0;
+#if defined(EASE_AVX)
+    const __m256 s8 = _mm256_set1_ps(s);
+    for (; i + 8 <= n; i += 8)
+        _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_loadu_ps(a + i), s8));
+#endif
+#if defined(EASE_SSE)
+    const __m128 s4 = _mm_set1_ps(s);
+    for (; i + 4 <= n; i += 4)
+        _mm_storeu_ps(out + i, _mm_mul_ps(_mm_loadu_ps(a + i), s4));
+#endif
+    for (; i < n; ++i) out[i] = a[i] * s;
+}
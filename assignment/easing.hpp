@@ -0,0 +1,25 @@
+#pragma once
+
+// ---------------- Shared easing / interpolation ----------------
+// One definition of the curves the animation systems use. The scalar helpers
+// are inline; the *N kernels evaluate a whole array of animation channels in
+// one call (AVX or SSE when the compiler targets them, scalar otherwise).
+
+inline float clamp01(float t) { return t < 0.0f ? 0.0f : (t > 1.0f ? 1.0f : t); }
+inline float lerpf(float a, float b, float t) { return a + (b - a) * t; }
+
+// Hermite ease-in-out on an already normalised t (0..1)
+inline float smooth01(float t) { return t * t * (3.0f - 2.0f * t); }
+
+// GLSL-style smoothstep: clamps (x - e0) / (e1 - e0) first
+inline float smoothstep(float edge0, float edge1, float x) {
+    return smooth01(clamp01((x - edge0) / (edge1 - edge0)));
+}
+
+// Quadratic ease-out (fast start, soft landing)
+inline float easeOutQuad(float t) { return 1.0f - (1.0f - t) * (1.0f - t); }
+
+// ---------------- Batch kernels (n channels at once) ----------------
+// out may alias any input.
+void lerpN(const float* a, const float* b, float t, float* out, int n);      // a + (b - a) * t
+void scaleN(const float* a, float s, float* out, int n);                     // a * s
@@ -1,6 +1,11 @@
 #include "flower.hpp"
 #include "utils.hpp"
+#include "easing.hpp"
+#include "animScheduler.hpp"
+#include "meshInstancing.hpp"
+#include "textureStreaming.hpp"
 #include <cmath>
+#include <vector>
 #include <GL/freeglut.h>
 
 #ifndef M_PI
@@ -9,12 +14,12 @@
 
 FlowerBloomState flowerBloom;
 
-static inline float smooth01(float t) { return t * t * (3.0f - 2.0f * t); }
-
 void triggerFlowerBloom() {
+    prefetchTexture(gTex.lotus);
     flowerBloom.isActive = true;
     flowerBloom.time = 0.0f;
     flowerBloom.progress = 0.0f;
+    scheduleAnimation(ANIMSYS_FLOWER_BLOOM);
 }
 
 void updateFlowerBloomAnimation() {
@@ -31,10 +36,46 @@ void updateFlowerBloomAnimation() {
     }
 }
 
+// Cached petal sphere, centre torus (unit-R display list) and the per-frame
+// petal instances: an inner ring offset by half a petal, then the outer ring
+static InstancedMesh gPetalMesh;
+static GLuint gCenterTorusList = 0;
+static std::vector<MeshInstance> gPetalInstances;
+
+static void buildPetalInstances(int petals, float R) {
+    gPetalInstances.resize((size_t)petals * 2);
+    int n = 0;
+    for (int ring = 0; ring < 2; ++ring) {
+        const float ringScale = (ring == 0 ? 0.75f : 1.0f);
+        for (int i = 0; i < petals; ++i) {
+            float a = (2.0f * (float)M_PI * i) / petals + (ring == 0 ? (float)M_PI / petals : 0.0f);
+            MeshInstance& petal = gPetalInstances[n++];
+            petal.xform = xformIdentity();
+            xformRotate(petal.xform, a * 180.0f / (float)M_PI, 0, 0, 1);
+            xformTranslate(petal.xform, 0.65f * R * ringScale, 0.0f, 0.0f);
+            xformScale(petal.xform, 0.40f * R * ringScale, 0.20f * R * ringScale, 1.0f);
+            petal.rgba[0] = petal.rgba[1] = petal.rgba[2] = petal.rgba[3] = 1.0f;
+        }
+    }
+}
+
 // Draw a flat blooming flower on the ground at world position (x,y,z)
 void drawFlowerBloomAt(float x, float y, float z) {
     if (flowerBloom.progress <= 0.0f) return;
 
+    const int petals = flowerBloom.petals;
+    const float R = flowerBloom.maxRadius * flowerBloom.progress;
+    buildSphereMesh(gPetalMesh, 16, 12);
+    buildPetalInstances(petals, R);
+
+    if (!gCenterTorusList) {
+        // torus radii scale with R, so cache it at R = 1 and scale on draw
+        gCenterTorusList = glGenLists(1);
+        glNewList(gCenterTorusList, GL_COMPILE);
+        glutSolidTorus(0.01f, 0.10f, 10, 24);
+        glEndList();
+    }
+
     glPushAttrib(GL_ENABLE_BIT | GL_CURRENT_BIT | GL_TEXTURE_BIT | GL_COLOR_BUFFER_BIT);
     glDisable(GL_LIGHTING);
 
@@ -42,34 +83,19 @@ void drawFlowerBloomAt(float x, float y, float z) {
     glTranslatef(x, y + 0.01f, z);   // avoid z-fight
     glRotatef(-90.0f, 1, 0, 0);      // draw in XZ plane
 
-    const int petals = flowerBloom.petals;
-    const float R = flowerBloom.maxRadius * flowerBloom.progress;
-
     // center disk (untextured)
     glColor3f(0.98f, 0.86f, 0.20f);
-    glutSolidTorus(0.01f * R, 0.10f * R, 10, 24);
+    glPushMatrix();
+    glScalef(R, R, R);
+    glCallList(gCenterTorusList);
+    glPopMatrix();
 
     // petals: use lotus texture
     glEnable(GL_TEXTURE_2D);
-    glBindTexture(GL_TEXTURE_2D, gTex.lotus);
+    glBindTexture(GL_TEXTURE_2D, useTexture(gTex.lotus));
     glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
     glColor3f(1, 1, 1);
-
-    for (int ring = 0; ring < 2; ++ring) {
-        const float ringScale = (ring == 0 ? 0.75f : 1.0f);
-        for (int i = 0; i < petals; ++i) {
-            float a = (2.0f * (float)M_PI * i) / petals + (ring == 0 ? (float)M_PI / petals : 0.0f);
-            glPushMatrix();
-            glRotatef(a * 180.0f / (float)M_PI, 0, 0, 1);
-            glTranslatef(0.65f * R * ringScale, 0.0f, 0.0f);
-            glScalef(0.40f * R * ringScale, 0.20f * R * ringScale, 1.0f);
-
-            // textured "petal" sphere
-            drawSpherePrim(1.0f, 16, 12);
-
-            glPopMatrix();
-        }
-    }
+    drawMeshInstances(gPetalMesh, gPetalInstances.data(), (int)gPetalInstances.size(), true);
 
     glPopMatrix();
     glPopAttrib();
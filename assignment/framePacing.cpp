@@ -0,0 +1,64 @@
+#include "framePacing.hpp"
+#include "animScheduler.hpp"
+#include "nezha_bg.hpp"
+#include "inputReplay.hpp"
+#include "textureStreaming.hpp"
+#include "textureAtlas.hpp"
+#include <cstdio>
+
+FramePacingState gFramePacing;
+
+bool sceneIsAnimating() {
+    // systems drop out of the scheduler as soon as they finish; streamed
+    // textures need frames to be uploaded in
+    return animationsActive() || pendingStreamedTextures() > 0 || textureAtlasPending();
+}
+
+static void onPacingTimer(int) {
+    gFramePacing.timerPending = false;
+    glutPostRedisplay();
+}
+
+static void scheduleFrameIn(int ms) {
+    if (gFramePacing.timerPending) return;
+    gFramePacing.timerPending = true;
+    glutTimerFunc(ms > 0 ? (unsigned)ms : 0u, onPacingTimer, 0);
+}
+
+// Legacy path: keep GLUT spinning and redraw every time it is idle.
+static void legacyIdle() { glutPostRedisplay(); }
+
+void initFramePacing() {
+    glutIdleFunc(gFramePacing.enabled ? nullptr : legacyIdle);
+    requestRedraw();
+}
+
+void framePacingBeginFrame() {
+    gFramePacing.frameStartMs = glutGet(GLUT_ELAPSED_TIME);
+}
+
+void framePacingEndFrame() {
+    // replay benchmarks run flat out on a fixed timestep
+    if (inputReplayIsPlaying()) { glutPostRedisplay(); return; }
+    if (!gFramePacing.enabled) return;
+
+    int hz = 0;
+    if (sceneIsAnimating())      hz = gFramePacing.animationHz;
+    else if (gNezhaBG.enabled)   hz = gFramePacing.backgroundHz;
+    if (hz <= 0) return; // static scene: sleep until input posts a redisplay
+
+    // subtract the time this frame already took so the rate holds
+    const int spentMs = glutGet(GLUT_ELAPSED_TIME) - gFramePacing.frameStartMs;
+    scheduleFrameIn(1000 / hz - spentMs);
+}
+
+void requestRedraw() {
+    glutPostRedisplay();
+}
+
+void toggleFramePacing() {
+    gFramePacing.enabled = !gFramePacing.enabled;
+    glutIdleFunc(gFramePacing.enabled ? nullptr : legacyIdle);
+    std::printf("Frame pacing: %s\n", gFramePacing.enabled ? "ON" : "OFF (redraw every idle)");
+    requestRedraw();
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include <GL/freeglut.h>
+
+// Frame pacing: decides when the next frame is drawn instead of posting a
+// redisplay from glutIdleFunc on every spin of the main loop.
+//  - something animating      -> redraw at animationHz
+//  - only the background moves -> redraw at backgroundHz
+//  - nothing moves            -> no timer; GLUT blocks until input arrives
+struct FramePacingState {
+    bool enabled = true;        // false = legacy behaviour (redraw every idle spin)
+    int  animationHz = 60;      // animations step a fixed 0.016s per frame
+    int  backgroundHz = 20;     // clouds/embers drift slowly, 20 Hz is plenty
+    bool timerPending = false;  // a redraw timer is already queued
+    int  frameStartMs = 0;      // GLUT time when the current frame began
+};
+
+extern FramePacingState gFramePacing;
+
+// True while any animation system still has work to do this frame.
+bool sceneIsAnimating();
+
+void initFramePacing();            // call once after the window is created
+void framePacingBeginFrame();      // first thing in display()
+void framePacingEndFrame();        // last thing in display(), schedules the next frame
+void requestRedraw();              // input or state change: draw one frame soon
+void toggleFramePacing();
@@ -0,0 +1,138 @@
+#include "glExtensions.hpp"
+#include <cstdio>
+#include <vector>
+
+GLExtensions gGL;
+
+template <typename Fn>
+static bool loadProc(Fn& fn, const char* name) {
+    fn = reinterpret_cast<Fn>(glutGetProcAddress(name));
+    return fn != nullptr;
+}
+
+bool initGLExtensions() {
+    static bool tried = false, ok = false;
+    if (tried) return ok;
+    tried = true;
+
+    const char* version = (const char*)glGetString(GL_VERSION);
+    if (!version || std::sscanf(version, "%d.%d", &gGL.major, &gGL.minor) != 2) {
+        gGL.major = 1; gGL.minor = 1;
+    }
+
+    ok = true;
+    ok &= loadProc(gGL.createShader, "glCreateShader");
+    ok &= loadProc(gGL.shaderSource, "glShaderSource");
+    ok &= loadProc(gGL.compileShader, "glCompileShader");
+    ok &= loadProc(gGL.getShaderiv, "glGetShaderiv");
+    ok &= loadProc(gGL.getShaderInfoLog, "glGetShaderInfoLog");
+    ok &= loadProc(gGL.deleteShader, "glDeleteShader");
+    ok &= loadProc(gGL.createProgram, "glCreateProgram");
+    ok &= loadProc(gGL.attachShader, "glAttachShader");
+    ok &= loadProc(gGL.linkProgram, "glLinkProgram");
+    ok &= loadProc(gGL.getProgramiv, "glGetProgramiv");
+    ok &= loadProc(gGL.getProgramInfoLog, "glGetProgramInfoLog");
+    ok &= loadProc(gGL.deleteProgram, "glDeleteProgram");
+    ok &= loadProc(gGL.useProgram, "glUseProgram");
+    ok &= loadProc(gGL.getUniformLocation, "glGetUniformLocation");
+    ok &= loadProc(gGL.uniform1i, "glUniform1i");
+    ok &= loadProc(gGL.uniform1f, "glUniform1f");
+    ok &= loadProc(gGL.uniform2f, "glUniform2f");
+    ok &= loadProc(gGL.uniform3f, "glUniform3f");
+    ok &= loadProc(gGL.uniform1fv, "glUniform1fv");
+    ok &= loadProc(gGL.uniform3fv, "glUniform3fv");
+    ok &= loadProc(gGL.uniform4fv, "glUniform4fv");
+    ok &= loadProc(gGL.vertexAttribPointer, "glVertexAttribPointer");
+    ok &= loadProc(gGL.enableVertexAttribArray, "glEnableVertexAttribArray");
+    ok &= loadProc(gGL.disableVertexAttribArray, "glDisableVertexAttribArray");
+    ok &= loadProc(gGL.genBuffers, "glGenBuffers");
+    ok &= loadProc(gGL.deleteBuffers, "glDeleteBuffers");
+    ok &= loadProc(gGL.bindBuffer, "glBindBuffer");
+    ok &= loadProc(gGL.bufferData, "glBufferData");
+    ok &= loadProc(gGL.bufferSubData, "glBufferSubData");
+
+    // optional: only meaningful on 3.0 / 3.3 / 4.3+ contexts
+    if (glVersionAtLeast(3, 0)) {
+        loadProc(gGL.genFramebuffers, "glGenFramebuffers");
+        loadProc(gGL.deleteFramebuffers, "glDeleteFramebuffers");
+        loadProc(gGL.bindFramebuffer, "glBindFramebuffer");
+        loadProc(gGL.framebufferTexture2D, "glFramebufferTexture2D");
+        loadProc(gGL.checkFramebufferStatus, "glCheckFramebufferStatus");
+    }
+    if (glVersionAtLeast(3, 3)) {
+        loadProc(gGL.vertexAttribDivisor, "glVertexAttribDivisor");
+        loadProc(gGL.drawElementsInstanced, "glDrawElementsInstanced");
+    }
+    if (glVersionAtLeast(4, 3)) {
+        loadProc(gGL.bindBufferBase, "glBindBufferBase");
+        loadProc(gGL.dispatchCompute, "glDispatchCompute");
+        loadProc(gGL.memoryBarrier, "glMemoryBarrier");
+    }
+
+    gGL.loaded = ok;
+    std::printf("OpenGL %d.%d (%s): shader path %s\n", gGL.major, gGL.minor,
+        (const char*)glGetString(GL_RENDERER), ok ? "available" : "unavailable");
+    return ok;
+}
+
+bool glVersionAtLeast(int major, int minor) {
+    return gGL.major > major || (gGL.major == major && gGL.minor >= minor);
+}
+
+static GLuint compileStage(GLenum type, const char* src) {
+    GLuint shader = gGL.createShader(type);
+    gGL.shaderSource(shader, 1, &src, nullptr);
+    gGL.compileShader(shader);
+
+    GLint status = 0;
+    gGL.getShaderiv(shader, GL_COMPILE_STATUS, &status);
+    if (!status) {
+        GLint len = 0;
+        gGL.getShaderiv(shader, GL_INFO_LOG_LENGTH, &len);
+        std::vector<char> log(len > 1 ? len : 1, '\0');
+        gGL.getShaderInfoLog(shader, (GLsizei)log.size(), nullptr, log.data());
+        std::printf("Shader compile failed:\n%s\n", log.data());
+        gGL.deleteShader(shader);
+        return 0;
+    }
+    return shader;
+}
+
+static GLuint linkStages(const GLuint* stages, int count) {
+    GLuint program = gGL.createProgram();
+    for (int i = 0; i < count; ++i) gGL.attachShader(program, stages[i]);
+    gGL.linkProgram(program);
+    for (int i = 0; i < count; ++i) gGL.deleteShader(stages[i]); // freed with the program
+
+    GLint status = 0;
+    gGL.getProgramiv(program, GL_LINK_STATUS, &status);
+    if (!status) {
+        GLint len = 0;
+        gGL.getProgramiv(program, GL_INFO_LOG_LENGTH, &len);
+        std::vector<char> log(len > 1 ? len : 1, '\0');
+        gGL.getProgramInfoLog(program, (GLsizei)log.size(), nullptr, log.data());
+        std::printf("Program link failed:\n%s\n", log.data());
+        gGL.deleteProgram(program);
+        return 0;
+    }
+    return program;
+}
+
+GLuint buildGLProgram(const char* vertexSrc, const char* fragmentSrc) {
+    if (!initGLExtensions()) return 0;
+    GLuint stages[2];
+    stages[0] = compileStage(GL_VERTEX_SHADER, vertexSrc);
+    stages[1] = compileStage(GL_FRAGMENT_SHADER, fragmentSrc);
+    if (!stages[0] || !stages[1]) {
+        if (stages[0]) gGL.deleteShader(stages[0]);
+        if (stages[1]) gGL.deleteShader(stages[1]);
+        return 0;
+    }
+    return linkStages(stages, 2);
+}
+
+GLuint buildGLComputeProgram(const char* computeSrc) {
+    if (!initGLExtensions() || !gGL.dispatchCompute) return 0;
+    GLuint stage = compileStage(GL_COMPUTE_SHADER, computeSrc);
+    return stage ? linkStages(&stage, 1) : 0;
+}
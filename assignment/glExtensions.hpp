@@ -0,0 +1,106 @@
+#pragma once
+#include <GL/freeglut.h>
+#include <cstddef>
+
+// ---------------- GL entry points beyond 1.1 ----------------
+// The Windows SDK headers stop at GL 1.1, so anything newer (GLSL, buffer
+// objects, compute) is fetched at runtime through glutGetProcAddress after
+// the window exists. Callers check glVersionAtLeast() / the pointer before
+// taking a shader path and keep their fixed-function path as the fallback.
+
+#ifndef APIENTRY
+#define APIENTRY
+#endif
+
+#ifndef GL_ARRAY_BUFFER
+#define GL_ARRAY_BUFFER                   0x8892
+#define GL_STREAM_DRAW                    0x88E0
+#define GL_STATIC_DRAW                    0x88E4
+#define GL_DYNAMIC_DRAW                   0x88E8
+#endif
+#ifndef GL_ELEMENT_ARRAY_BUFFER
+#define GL_ELEMENT_ARRAY_BUFFER           0x8893
+#endif
+#ifndef GL_FRAGMENT_SHADER
+#define GL_FRAGMENT_SHADER                0x8B30
+#define GL_VERTEX_SHADER                  0x8B31
+#define GL_COMPILE_STATUS                 0x8B81
+#define GL_LINK_STATUS                    0x8B82
+#define GL_INFO_LOG_LENGTH                0x8B84
+#endif
+#ifndef GL_FRAMEBUFFER
+#define GL_FRAMEBUFFER                    0x8D40
+#define GL_COLOR_ATTACHMENT0              0x8CE0
+#define GL_FRAMEBUFFER_COMPLETE           0x8CD5
+#endif
+#ifndef GL_COMPUTE_SHADER
+#define GL_COMPUTE_SHADER                 0x91B9
+#define GL_SHADER_STORAGE_BUFFER          0x90D2
+#define GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT 0x00000001
+#define GL_SHADER_STORAGE_BARRIER_BIT     0x00002000
+#endif
+
+struct GLExtensions {
+    bool loaded = false;
+    int  major = 1, minor = 1;   // context version from GL_VERSION
+
+    // GLSL (2.0)
+    GLuint (APIENTRY* createShader)(GLenum type) = nullptr;
+    void   (APIENTRY* shaderSource)(GLuint shader, GLsizei count, const char* const* src, const GLint* len) = nullptr;
+    void   (APIENTRY* compileShader)(GLuint shader) = nullptr;
+    void   (APIENTRY* getShaderiv)(GLuint shader, GLenum pname, GLint* out) = nullptr;
+    void   (APIENTRY* getShaderInfoLog)(GLuint shader, GLsizei max, GLsizei* len, char* log) = nullptr;
+    void   (APIENTRY* deleteShader)(GLuint shader) = nullptr;
+    GLuint (APIENTRY* createProgram)() = nullptr;
+    void   (APIENTRY* attachShader)(GLuint program, GLuint shader) = nullptr;
+    void   (APIENTRY* linkProgram)(GLuint program) = nullptr;
+    void   (APIENTRY* getProgramiv)(GLuint program, GLenum pname, GLint* out) = nullptr;
+    void   (APIENTRY* getProgramInfoLog)(GLuint program, GLsizei max, GLsizei* len, char* log) = nullptr;
+    void   (APIENTRY* deleteProgram)(GLuint program) = nullptr;
+    void   (APIENTRY* useProgram)(GLuint program) = nullptr;
+    GLint  (APIENTRY* getUniformLocation)(GLuint program, const char* name) = nullptr;
+    void   (APIENTRY* uniform1i)(GLint loc, GLint v) = nullptr;
+    void   (APIENTRY* uniform1f)(GLint loc, GLfloat v) = nullptr;
+    void   (APIENTRY* uniform2f)(GLint loc, GLfloat x, GLfloat y) = nullptr;
+    void   (APIENTRY* uniform3f)(GLint loc, GLfloat x, GLfloat y, GLfloat z) = nullptr;
+    void   (APIENTRY* uniform1fv)(GLint loc, GLsizei count, const GLfloat* v) = nullptr;
+    void   (APIENTRY* uniform3fv)(GLint loc, GLsizei count, const GLfloat* v) = nullptr;
+    void   (APIENTRY* uniform4fv)(GLint loc, GLsizei count, const GLfloat* v) = nullptr;
+    void   (APIENTRY* vertexAttribPointer)(GLuint index, GLint size, GLenum type, GLboolean norm, GLsizei stride, const void* ptr) = nullptr;
+    void   (APIENTRY* enableVertexAttribArray)(GLuint index) = nullptr;
+    void   (APIENTRY* disableVertexAttribArray)(GLuint index) = nullptr;
+
+    // Buffer objects (1.5)
+    void (APIENTRY* genBuffers)(GLsizei n, GLuint* buffers) = nullptr;
+    void (APIENTRY* deleteBuffers)(GLsizei n, const GLuint* buffers) = nullptr;
+    void (APIENTRY* bindBuffer)(GLenum target, GLuint buffer) = nullptr;
+    void (APIENTRY* bufferData)(GLenum target, ptrdiff_t size, const void* data, GLenum usage) = nullptr;
+    void (APIENTRY* bufferSubData)(GLenum target, ptrdiff_t offset, ptrdiff_t size, const void* data) = nullptr;
+
+    // Framebuffer objects (3.0)
+    void   (APIENTRY* genFramebuffers)(GLsizei n, GLuint* fbos) = nullptr;
+    void   (APIENTRY* deleteFramebuffers)(GLsizei n, const GLuint* fbos) = nullptr;
+    void   (APIENTRY* bindFramebuffer)(GLenum target, GLuint fbo) = nullptr;
+    void   (APIENTRY* framebufferTexture2D)(GLenum target, GLenum attachment, GLenum texTarget, GLuint tex, GLint level) = nullptr;
+    GLenum (APIENTRY* checkFramebufferStatus)(GLenum target) = nullptr;
+
+    // Instancing (3.3)
+    void (APIENTRY* vertexAttribDivisor)(GLuint index, GLuint divisor) = nullptr;
+    void (APIENTRY* drawElementsInstanced)(GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei instances) = nullptr;
+
+    // Compute (4.3)
+    void (APIENTRY* bindBufferBase)(GLenum target, GLuint index, GLuint buffer) = nullptr;
+    void (APIENTRY* dispatchCompute)(GLuint x, GLuint y, GLuint z) = nullptr;
+    void (APIENTRY* memoryBarrier)(GLbitfield barriers) = nullptr;
+};
+
+extern GLExtensions gGL;
+
+// Load once the GL context is current (later calls return the cached result).
+// Returns false when even GLSL + buffer objects are missing.
+bool initGLExtensions();
+bool glVersionAtLeast(int major, int minor);
+
+// Compile/link helpers; print the info log and return 0 on failure.
+GLuint buildGLProgram(const char* vertexSrc, const char* fragmentSrc);
+GLuint buildGLComputeProgram(const char* computeSrc);
@@ -0,0 +1,233 @@
+#include "gpuParticles.hpp"
+#include "glExtensions.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+// Slot layout shared with the kernels: 4 x vec4 per particle
+//   posLife    = (x, y, z, life)
+//   velMaxLife = (vx, vy, vz, maxLife)
+//   color      = (r, g, b, a)
+//   sizeGrowth = (size, growth, 0, 0)
+static const int kSlotFloats = 16;
+static const int kQuadVertexFloats = 9;   // xyz, uv, rgba
+static const int kGroupSize = 256;
+
+static const char* kStepSrc = R"(#version 430
+layout(local_size_x = 256) in;
+struct Particle { vec4 posLife; vec4 velMaxLife; vec4 color; vec4 sizeGrowth; };
+layout(std430, binding = 0) buffer Particles { Particle particles[]; };
+uniform int   uCount;
+uniform float uDt;
+uniform vec3  uAccel;
+uniform vec2  uSpin;   // cos, sin of the Y rotation since the last step
+
+vec2 spin(vec2 xz) { return vec2(uSpin.x * xz.x + uSpin.y * xz.y, -uSpin.y * xz.x + uSpin.x * xz.y); }
+
+void main() {
+    int i = int(gl_GlobalInvocationID.x);
+    if (i >= uCount) return;
+    Particle p = particles[i];
+    if (p.posLife.w <= 0.0) return;
+
+    p.posLife.xz = spin(p.posLife.xz);
+    p.velMaxLife.xz = spin(p.velMaxLife.xz);
+    p.velMaxLife.xyz += uAccel * uDt;
+    p.posLife.xyz += p.velMaxLife.xyz * uDt;
+    p.posLife.w -= uDt;
+    p.sizeGrowth.x += p.sizeGrowth.y * uDt;
+    particles[i] = p;
+}
+)";
+
+static const char* kExpandSrc = R"(#version 430
+layout(local_size_x = 256) in;
+struct Particle { vec4 posLife; vec4 velMaxLife; vec4 color; vec4 sizeGrowth; };
+layout(std430, binding = 0) readonly buffer Particles { Particle particles[]; };
+layout(std430, binding = 1) writeonly buffer Quads { float quads[]; };
+uniform int  uCount;
+uniform vec3 uRight;
+uniform vec3 uUp;
+
+const vec2 kCorner[4] = vec2[4](vec2(-1.0, -1.0), vec2(1.0, -1.0), vec2(1.0, 1.0), vec2(-1.0, 1.0));
+
+void main() {
+    int i = int(gl_GlobalInvocationID.x);
+    if (i >= uCount) return;
+    Particle p = particles[i];
+    bool alive = p.posLife.w > 0.0;
+    float s = alive ? p.sizeGrowth.x : 0.0;
+    float alpha = alive ? p.color.a * (p.posLife.w / p.velMaxLife.w) : 0.0;
+
+    for (int c = 0; c < 4; ++c) {
+        vec3 pos = p.posLife.xyz + uRight * (kCorner[c].x * s) + uUp * (kCorner[c].y * s);
+        vec2 uv = kCorner[c] * 0.5 + 0.5;
+        int o = (i * 4 + c) * 9;
+        quads[o + 0] = pos.x; quads[o + 1] = pos.y; quads[o + 2] = pos.z;
+        quads[o + 3] = uv.x;  quads[o + 4] = uv.y;
+        quads[o + 5] = p.color.r; quads[o + 6] = p.color.g; quads[o + 7] = p.color.b;
+        quads[o + 8] = alpha;
+    }
+}
+)";
+
+struct GpuParticleMirror {
+    GLuint particles = 0;       // SSBO, capacity slots
+    GLuint quads = 0;           // vertex buffer, 4 vertices per slot
+    int capacity = 0;
+    int head = 0;               // where the search for a dead slot starts
+    int used = 0;               // slots [0, used) have ever been written
+    int live = 0;               // slots alive as of the last step
+    float clock = 0.0f;         // simulated seconds, for the live estimate
+    float spin = 0.0f;          // radians queued by gpuSpinParticles
+    std::vector<float> deathTime;   // per slot, CPU copy for counting only
+    std::vector<float> staging;     // AoS upload scratch
+};
+
+static GLuint gStepProgram = 0, gExpandProgram = 0;
+
+bool gpuParticlesAvailable() {
+    static int state = -1;   // -1 unknown, 0 no, 1 yes
+    if (state >= 0) return state == 1;
+
+    state = 0;
+    if (initGLExtensions() && glVersionAtLeast(4, 3) && gGL.dispatchCompute) {
+        gStepProgram = buildGLComputeProgram(kStepSrc);
+        gExpandProgram = buildGLComputeProgram(kExpandSrc);
+        state = (gStepProgram && gExpandProgram) ? 1 : 0;
+    }
+    std::printf("Compute-shader particles: %s\n", state ? "available" : "unavailable (CPU path only)");
+    return state == 1;
+}
+
+static GpuParticleMirror* createMirror(int capacity) {
+    GpuParticleMirror* m = new GpuParticleMirror();
+    m->capacity = capacity > 0 ? capacity : 1;
+    m->deathTime.assign(m->capacity, 0.0f);
+
+    // zero-filled slots are dead (life 0)
+    std::vector<float> zeros((size_t)m->capacity * kSlotFloats, 0.0f);
+    gGL.genBuffers(1, &m->particles);
+    gGL.bindBuffer(GL_SHADER_STORAGE_BUFFER, m->particles);
+    gGL.bufferData(GL_SHADER_STORAGE_BUFFER, (ptrdiff_t)zeros.size() * sizeof(float), zeros.data(), GL_DYNAMIC_DRAW);
+    gGL.bindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    gGL.genBuffers(1, &m->quads);
+    gGL.bindBuffer(GL_ARRAY_BUFFER, m->quads);
+    gGL.bufferData(GL_ARRAY_BUFFER, (ptrdiff_t)m->capacity * 4 * kQuadVertexFloats * sizeof(float), nullptr, GL_DYNAMIC_DRAW);
+    gGL.bindBuffer(GL_ARRAY_BUFFER, 0);
+    return m;
+}
+
+void releaseGpuParticles(ParticlePool& pool) {
+    GpuParticleMirror* m = pool.gpu;
+    if (!m) return;
+    gGL.deleteBuffers(1, &m->particles);
+    gGL.deleteBuffers(1, &m->quads);
+    delete m;
+    pool.gpu = nullptr;
+}
+
+// Copy slots [first, first + n) of the staging block into the bound particle buffer
+static void uploadSlots(int first, int n, const float* src) {
+    if (n <= 0) return;
+    gGL.bufferSubData(GL_SHADER_STORAGE_BUFFER,
+        (ptrdiff_t)first * kSlotFloats * sizeof(float),
+        (ptrdiff_t)n * kSlotFloats * sizeof(float), src);
+}
+
+// Move the pool's pending CPU spawns into dead ring slots. Slots still in
+// flight are stepped over, never overwritten; spawnParticle keeps the pending
+// count within the free slots, so nothing is left over.
+static void uploadPending(ParticlePool& p, GpuParticleMirror& m) {
+    const int n = p.count;
+    if (n <= 0) return;
+
+    m.staging.resize((size_t)n * kSlotFloats);
+    float* s = m.staging.data();
+    for (int i = 0; i < n; ++i, s += kSlotFloats) {
+        s[0] = p.px[i]; s[1] = p.py[i]; s[2] = p.pz[i]; s[3] = p.life[i];
+        s[4] = p.vx[i]; s[5] = p.vy[i]; s[6] = p.vz[i]; s[7] = p.maxLife[i];
+        s[8] = p.r[i];  s[9] = p.g[i];  s[10] = p.b[i]; s[11] = p.a[i];
+        s[12] = p.size[i]; s[13] = p.growth[i]; s[14] = 0.0f; s[15] = 0.0f;
+    }
+
+    gGL.bindBuffer(GL_SHADER_STORAGE_BUFFER, m.particles);
+    int done = 0;
+    for (int scanned = 0; done < n && scanned < m.capacity; ) {
+        // one contiguous run of dead slots (never-written slots have deathTime 0)
+        int run = 0;
+        while (done + run < n && m.head + run < m.capacity && m.deathTime[m.head + run] <= m.clock) ++run;
+        if (run > 0) {
+            uploadSlots(m.head, run, m.staging.data() + (size_t)done * kSlotFloats);
+            for (int k = 0; k < run; ++k) m.deathTime[m.head + k] = m.clock + p.life[done + k];
+            done += run;
+        }
+        const int advance = run > 0 ? run : 1;   // step over a live slot
+        m.head += advance;
+        scanned += advance;
+        if (m.head > m.used) m.used = m.head;
+        if (m.head == m.capacity) m.head = 0;
+    }
+    m.live += done;
+    gGL.bindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    p.count = 0;
+}
+
+void gpuStepParticles(ParticlePool& p, float dt, float ax, float ay, float az) {
+    if (!p.gpu) p.gpu = createMirror(p.capacity);  // live CPU particles upload as spawns
+    GpuParticleMirror& m = *p.gpu;
+
+    uploadPending(p, m);
+    m.clock += dt;
+    m.live = 0;
+    for (int i = 0; i < m.used; ++i)
+        if (m.deathTime[i] > m.clock) ++m.live;
+    if (m.used == 0) return;
+
+    gGL.useProgram(gStepProgram);
+    gGL.uniform1i(gGL.getUniformLocation(gStepProgram, "uCount"), m.used);
+    gGL.uniform1f(gGL.getUniformLocation(gStepProgram, "uDt"), dt);
+    gGL.uniform3f(gGL.getUniformLocation(gStepProgram, "uAccel"), ax, ay, az);
+    gGL.uniform2f(gGL.getUniformLocation(gStepProgram, "uSpin"), std::cos(m.spin), std::sin(m.spin));
+    gGL.bindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, m.particles);
+    gGL.dispatchCompute((GLuint)((m.used + kGroupSize - 1) / kGroupSize), 1, 1);
+    gGL.memoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+    gGL.useProgram(0);
+    m.spin = 0.0f;
+}
+
+void gpuSpinParticles(ParticlePool& p, float radians) {
+    if (p.gpu) p.gpu->spin += radians;
+}
+
+int gpuLiveParticles(const ParticlePool& p) {
+    return p.gpu ? p.count + p.gpu->live : p.count;
+}
+
+int gpuFreeSlots(const ParticlePool& p) {
+    return p.gpu ? p.gpu->capacity - p.gpu->live : p.capacity;
+}
+
+int gpuExpandBillboards(const ParticlePool& p, const float right[3], const float up[3]) {
+    const GpuParticleMirror* m = p.gpu;
+    if (!m || m->used == 0) return 0;
+
+    gGL.useProgram(gExpandProgram);
+    gGL.uniform1i(gGL.getUniformLocation(gExpandProgram, "uCount"), m->used);
+    gGL.uniform3f(gGL.getUniformLocation(gExpandProgram, "uRight"), right[0], right[1], right[2]);
+    gGL.uniform3f(gGL.getUniformLocation(gExpandProgram, "uUp"), up[0], up[1], up[2]);
+    gGL.bindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, m->particles);
+    gGL.bindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, m->quads);
+    gGL.dispatchCompute((GLuint)((m->used + kGroupSize - 1) / kGroupSize), 1, 1);
+    gGL.memoryBarrier(GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT);
+    gGL.useProgram(0);
+
+    gGL.bindBuffer(GL_ARRAY_BUFFER, m->quads);
+    return m->used;
+}
+
+void gpuUnbindQuads() {
+    gGL.bindBuffer(GL_ARRAY_BUFFER, 0);
+}
@@ -0,0 +1,27 @@
+#pragma once
+#include "particles.hpp"
+
+// ---------------- Compute-shader particle backend ----------------
+// With gGpuParticles on and a GL 4.3 context, a pool's particles live in a
+// shader storage buffer instead of its CPU arrays. The CPU arrays then only
+// hold spawns made since the last step; stepParticles uploads them into a
+// ring of GPU slots (dead ones only) and dispatches the integrate kernel, and
+// drawParticleBillboards has a second kernel expand every slot into a quad
+// in a vertex buffer that is drawn directly (nothing is read back).
+// Dead slots expand to zero-size quads. These entry points are used by
+// particles.cpp; effects keep calling the normal pool functions.
+
+bool gpuParticlesAvailable();    // 4.3 compute + both kernels built (checked once)
+
+void gpuStepParticles(ParticlePool& pool, float dt, float ax, float ay, float az);
+void gpuSpinParticles(ParticlePool& pool, float radians);   // applied at the next step
+int  gpuLiveParticles(const ParticlePool& pool);            // estimate, includes pending spawns
+int  gpuFreeSlots(const ParticlePool& pool);                // ring slots pending spawns may fill
+
+// Fill the pool's quad buffer for the given camera axes and leave it bound
+// to GL_ARRAY_BUFFER (vertex: xyz, uv, rgba floats). Returns the quad count.
+int  gpuExpandBillboards(const ParticlePool& pool, const float right[3], const float up[3]);
+void gpuUnbindQuads();
+
+// Drop the GPU copy (its particles are lost); the pool is CPU-only again.
+void releaseGpuParticles(ParticlePool& pool);
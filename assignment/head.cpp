@@ -2,6 +2,8 @@
 #include "utils.hpp"
 #include "model.hpp"
 #include "meditation.hpp"   // for meditation eye closing
+#include "transparentPass.hpp"
+#include "textureAtlas.hpp"
 #include <GL/freeglut.h>
 #include <cmath>
 
@@ -285,11 +287,12 @@ static void drawEarPairHigh(float R) {
         glDisable(GL_TEXTURE_GEN_T);
         glEnable(GL_TEXTURE_2D);
         glColor3f(1, 1, 1);
-        glBindTexture(GL_TEXTURE_2D, gTex.pandaBlack);
+        beginAtlasTexture(gTex.pandaBlack);
         glPushMatrix();
         glScalef(sx, sy, sz);
         drawSpherePrim(earR, 18, 12);
         glPopMatrix();
+        endAtlasTexture();
         glBindTexture(GL_TEXTURE_2D, 0);
         glPopAttrib();
 
@@ -330,6 +333,21 @@ static void drawEarPairHigh(float R) {
     }
 }
 
+// Sphere-mapped reflection over the head dome. Texgen is the one piece of
+// state this item sets itself, so it is switched back off after the draw.
+static void drawQueuedHeadReflection(const TransparentItem& item) {
+    glTexGeni(GL_S, GL_TEXTURE_GEN_MODE, GL_SPHERE_MAP);
+    glTexGeni(GL_T, GL_TEXTURE_GEN_MODE, GL_SPHERE_MAP);
+    glEnable(GL_TEXTURE_GEN_S);
+    glEnable(GL_TEXTURE_GEN_T);
+    glColor4f(1, 1, 1, 0.22f); // reflection strength
+
+    drawSpherePrim(item.args[0], 32, 24);
+
+    glDisable(GL_TEXTURE_GEN_S);
+    glDisable(GL_TEXTURE_GEN_T);
+}
+
 // ===== Main head assembly =====
 void drawHeadUnit() {
     PolygonCounter::setCurrentPart(BodyPart::HEAD);
@@ -361,35 +379,16 @@ void drawHeadUnit() {
         glEnable(GL_TEXTURE_2D);
         glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
         glColor3f(1, 1, 1);
-        glBindTexture(GL_TEXTURE_2D, gTex.pandaWhite);
+        beginAtlasTexture(gTex.pandaWhite);
         drawSpherePrim(R, 32, 24);
+        endAtlasTexture();
         glBindTexture(GL_TEXTURE_2D, 0);
 
-        // environment reflection overlay using sphere-map
+        // environment reflection overlay using sphere-map (additive, in the
+        // transparent pass once the opaque scene is down)
         GLuint envTex = gTex.cloud ? gTex.cloud : (gTex.goldBelt ? gTex.goldBelt : 0);
         if (envTex) {
-            glPushAttrib(GL_ENABLE_BIT | GL_TEXTURE_BIT | GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-            glEnable(GL_TEXTURE_2D);
-            glBindTexture(GL_TEXTURE_2D, envTex);
-            glTexGeni(GL_S, GL_TEXTURE_GEN_MODE, GL_SPHERE_MAP);
-            glTexGeni(GL_T, GL_TEXTURE_GEN_MODE, GL_SPHERE_MAP);
-            glEnable(GL_TEXTURE_GEN_S);
-            glEnable(GL_TEXTURE_GEN_T);
-
-            glDisable(GL_LIGHTING);
-            glDepthMask(GL_FALSE);
-            glEnable(GL_BLEND);
-            glBlendFunc(GL_SRC_ALPHA, GL_ONE);
-            glColor4f(1, 1, 1, 0.22f); // reflection strength
-
-            drawSpherePrim(R, 32, 24);
-
-            glDepthMask(GL_TRUE);
-            glDisable(GL_BLEND);
-            glDisable(GL_TEXTURE_GEN_S);
-            glDisable(GL_TEXTURE_GEN_T);
-            glBindTexture(GL_TEXTURE_2D, 0);
-            glPopAttrib();
+            queueTransparent(0, 0, 0, BLEND_ADDITIVE, envTex, drawQueuedHeadReflection).args[0] = R;
         }
 
         glPopMatrix();
@@ -0,0 +1,88 @@
+#include "impostors.hpp"
+#include "particles.hpp"
+#include "utils.hpp"
+#include <cmath>
+#include <vector>
+
+struct ImpostorBatch {
+    int first, count;
+};
+
+// Frame storage: batches point into gImpostors by index, so growing the
+// vector while queueing never invalidates an item. Reset on a new frame.
+static std::vector<Impostor> gImpostors;
+static std::vector<ImpostorBatch> gBatches;
+static int gStorageFrame = -1;
+
+static std::vector<float> gPos, gUV, gColor;
+
+static void drawQueuedImpostors(const TransparentItem& item) {
+    const ImpostorBatch& batch = gBatches[(size_t)item.args[0]];
+    const Impostor* imp = gImpostors.data() + batch.first;
+    const int n = batch.count;
+
+    // camera right/up in batch space (rows of its modelview, unscaled)
+    const GLfloat* m = item.modelview;
+    float rx = m[0], ry = m[4], rz = m[8];
+    float ux = m[1], uy = m[5], uz = m[9];
+    const float rl = std::sqrt(rx * rx + ry * ry + rz * rz);
+    const float ul = std::sqrt(ux * ux + uy * uy + uz * uz);
+    if (rl > 0.0f) { rx /= rl; ry /= rl; rz /= rl; }
+    if (ul > 0.0f) { ux /= ul; uy /= ul; uz /= ul; }
+
+    gPos.resize((size_t)n * 12);
+    gUV.resize((size_t)n * 8);
+    gColor.resize((size_t)n * 16);
+
+    static const float kCornerX[4] = { -1, 1, 1, -1 };
+    static const float kCornerY[4] = { -1, -1, 1, 1 };
+    float* pos = gPos.data();
+    float* uv = gUV.data();
+    float* col = gColor.data();
+    for (int i = 0; i < n; ++i) {
+        const Impostor& p = imp[i];
+        const float c = std::cos(p.spin) * p.size, s = std::sin(p.spin) * p.size;
+        for (int k = 0; k < 4; ++k) {
+            // corner rotated in the view plane by `spin`
+            const float sx = kCornerX[k] * c - kCornerY[k] * s;
+            const float sy = kCornerX[k] * s + kCornerY[k] * c;
+            *pos++ = p.x + rx * sx + ux * sy;
+            *pos++ = p.y + ry * sx + uy * sy;
+            *pos++ = p.z + rz * sx + uz * sy;
+            *uv++ = 0.5f + 0.5f * kCornerX[k];
+            *uv++ = 0.5f + 0.5f * kCornerY[k];
+            *col++ = p.r; *col++ = p.g; *col++ = p.b; *col++ = p.a;
+        }
+    }
+
+    glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    glVertexPointer(3, GL_FLOAT, 0, gPos.data());
+    glTexCoordPointer(2, GL_FLOAT, 0, gUV.data());
+    glColorPointer(4, GL_FLOAT, 0, gColor.data());
+    glDrawArrays(GL_QUADS, 0, n * 4);
+    countGLQuads(n);
+    glPopClientAttrib();
+}
+
+void queueImpostors(const Impostor* impostors, int count, TransparentBlend blend, GLuint texture) {
+    if (count <= 0) return;
+
+    const int frame = transparentPassFrame();
+    if (frame != gStorageFrame) {
+        gStorageFrame = frame;
+        gImpostors.clear();
+        gBatches.clear();
+    }
+
+    ImpostorBatch batch = { (int)gImpostors.size(), count };
+    gImpostors.insert(gImpostors.end(), impostors, impostors + count);
+    gBatches.push_back(batch);
+
+    if (!texture) texture = gTex.cloud ? gTex.cloud : particleSpriteTexture();
+    const Impostor& anchor = impostors[0];
+    TransparentItem& item = queueTransparent(anchor.x, anchor.y, anchor.z, blend, texture, drawQueuedImpostors);
+    item.args[0] = (float)(gBatches.size() - 1);
+}
@@ -0,0 +1,21 @@
+#pragma once
+#include <GL/freeglut.h>
+#include "transparentPass.hpp"
+
+// ---------------- Impostors ----------------
+// Soft puffs and glows drawn as camera-facing textured quads instead of
+// blended spheres. A batch of any size is one transparent-pass item and one
+// glDrawArrays; quads are expanded at flush time from the item's modelview,
+// so they face the camera wherever the batch was queued from.
+
+struct Impostor {
+    float x = 0, y = 0, z = 0;     // centre, in the space the batch is queued in
+    float size = 0.1f;             // half-width
+    float spin = 0.0f;             // in-plane rotation (radians), breaks up repeats
+    float r = 1, g = 1, b = 1, a = 1;
+};
+
+// Copy `count` impostors into this frame's batch storage and queue them as
+// one item sorted at the batch's first impostor. texture 0 = gTex.cloud (or
+// the soft particle sprite when the cloud texture is missing).
+void queueImpostors(const Impostor* impostors, int count, TransparentBlend blend, GLuint texture = 0);
@@ -0,0 +1,259 @@
+#include "inputReplay.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <vector>
+
+InputReplayState gInputReplay;
+
+// ---------- log format ----------
+enum InputEventType : uint8_t {
+    EV_KEY = 1,
+    EV_SPECIAL = 2,
+    EV_MOUSE = 3,
+    EV_MOTION = 4,
+    EV_WHEEL = 5,
+    EV_MENU = 6,
+    EV_END = 255          // written on exit; replay runs until this time
+};
+
+struct InputEvent {
+    uint32_t timeMs = 0;
+    uint8_t  type = 0;
+    uint8_t  a = 0;       // key / button / wheel
+    int16_t  x = 0, y = 0;
+    int16_t  b = 0;       // special key / button state / wheel direction
+};
+
+static const char     kMagic[4] = { 'N', 'Z', 'I', 'R' };
+static const uint16_t kVersion = 1;
+static const uint16_t kRecordSize = 12;
+
+static InputReplayHandlers gHandlers;
+static FILE* gLog = nullptr;           // recording target
+static int   gRecordStartMs = 0;
+
+static std::vector<InputEvent> gEvents; // playback source
+static size_t   gNextEvent = 0;
+static uint32_t gEndTimeMs = 0;
+static unsigned gFrame = 0;
+
+// playback timing
+typedef std::chrono::steady_clock Clock;
+static Clock::time_point gPlayStart, gFrameStart;
+static double gFrameMin = 1e9, gFrameMax = 0.0;
+static bool   gReported = false;
+
+// ---------- little-endian helpers (log is portable across hosts) ----------
+static void putU16(uint8_t* p, uint16_t v) { p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8); }
+static void putU32(uint8_t* p, uint32_t v) { putU16(p, (uint16_t)v); putU16(p + 2, (uint16_t)(v >> 16)); }
+static uint16_t getU16(const uint8_t* p) { return (uint16_t)(p[0] | (p[1] << 8)); }
+static uint32_t getU32(const uint8_t* p) { return getU16(p) | ((uint32_t)getU16(p + 2) << 16); }
+
+static void writeEvent(const InputEvent& e) {
+    uint8_t rec[kRecordSize];
+    putU32(rec + 0, e.timeMs);
+    rec[4] = e.type;
+    rec[5] = e.a;
+    putU16(rec + 6, (uint16_t)e.x);
+    putU16(rec + 8, (uint16_t)e.y);
+    putU16(rec + 10, (uint16_t)e.b);
+    std::fwrite(rec, 1, sizeof(rec), gLog);
+}
+
+static void record(uint8_t type, int a, int x, int y, int b) {
+    if (gInputReplay.mode != REPLAY_RECORDING || !gLog) return;
+    InputEvent e;
+    e.timeMs = (uint32_t)(glutGet(GLUT_ELAPSED_TIME) - gRecordStartMs);
+    e.type = type;
+    e.a = (uint8_t)a;
+    e.x = (int16_t)x; e.y = (int16_t)y;
+    e.b = (int16_t)b;
+    writeEvent(e);
+}
+
+static bool openRecording(const char* path) {
+    gLog = std::fopen(path, "wb");
+    if (!gLog) { std::printf("Input replay: cannot write '%s'\n", path); return false; }
+    uint8_t hdr[12];
+    std::memcpy(hdr, kMagic, 4);
+    putU16(hdr + 4, kVersion);
+    putU16(hdr + 6, kRecordSize);
+    putU32(hdr + 8, (uint32_t)gInputReplay.seed);
+    std::fwrite(hdr, 1, sizeof(hdr), gLog);
+    std::printf("Input replay: recording to '%s' (seed %d)\n", path, gInputReplay.seed);
+    return true;
+}
+
+static bool loadReplay(const char* path) {
+    FILE* f = std::fopen(path, "rb");
+    if (!f) { std::printf("Input replay: cannot open '%s'\n", path); return false; }
+
+    uint8_t hdr[12];
+    if (std::fread(hdr, 1, sizeof(hdr), f) != sizeof(hdr) || std::memcmp(hdr, kMagic, 4) != 0 ||
+        getU16(hdr + 4) != kVersion || getU16(hdr + 6) != kRecordSize) {
+        std::printf("Input replay: '%s' is not a v%d input log\n", path, kVersion);
+        std::fclose(f);
+        return false;
+    }
+    gInputReplay.seed = (int)getU32(hdr + 8);
+
+    uint8_t rec[kRecordSize];
+    while (std::fread(rec, 1, sizeof(rec), f) == sizeof(rec)) {
+        InputEvent e;
+        e.timeMs = getU32(rec + 0);
+        e.type = rec[4];
+        e.a = rec[5];
+        e.x = (int16_t)getU16(rec + 6);
+        e.y = (int16_t)getU16(rec + 8);
+        e.b = (int16_t)getU16(rec + 10);
+        if (e.type == EV_END) { gEndTimeMs = e.timeMs; break; }
+        gEvents.push_back(e);
+        gEndTimeMs = e.timeMs;
+    }
+    std::fclose(f);
+    std::printf("Input replay: %u events over %.2fs from '%s' (seed %d)\n",
+        (unsigned)gEvents.size(), gEndTimeMs * 0.001f, path, gInputReplay.seed);
+    return true;
+}
+
+static void report() {
+    if (gReported || gFrame == 0) return;
+    gReported = true;
+    const double totalMs = std::chrono::duration<double, std::milli>(Clock::now() - gPlayStart).count();
+    std::printf("\n=== INPUT REPLAY BENCHMARK ===\n");
+    std::printf("Frames: %u   Simulated: %.2fs   Wall: %.1f ms\n",
+        gFrame, gFrame * gInputReplay.fixedDt, totalMs);
+    std::printf("Frame ms  avg %.3f   min %.3f   max %.3f\n", totalMs / gFrame, gFrameMin, gFrameMax);
+    std::printf("==============================\n");
+}
+
+static void shutdownInputReplay() {
+    if (gInputReplay.mode == REPLAY_RECORDING && gLog) {
+        record(EV_END, 0, 0, 0, 0);
+        std::fclose(gLog);
+        gLog = nullptr;
+    }
+    else if (gInputReplay.mode == REPLAY_PLAYING) {
+        report();
+    }
+}
+
+// ---------- argv ----------
+void parseInputReplayArgs(int& argc, char** argv) {
+    const char* recordPath = nullptr;
+    const char* replayPath = nullptr;
+
+    int out = 1;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--record") && i + 1 < argc)      recordPath = argv[++i];
+        else if (!std::strcmp(argv[i], "--replay") && i + 1 < argc) replayPath = argv[++i];
+        else if (!std::strcmp(argv[i], "--seed") && i + 1 < argc)   gInputReplay.seed = std::atoi(argv[++i]);
+        else argv[out++] = argv[i];
+    }
+    argc = out;
+
+    if (replayPath) {
+        if (loadReplay(replayPath)) gInputReplay.mode = REPLAY_PLAYING;
+    }
+    else if (recordPath) {
+        if (openRecording(recordPath)) gInputReplay.mode = REPLAY_RECORDING;
+    }
+    if (gInputReplay.mode != REPLAY_OFF) std::atexit(shutdownInputReplay);
+}
+
+int inputReplaySeed() {
+    std::srand((unsigned)gInputReplay.seed);
+    return gInputReplay.seed;
+}
+
+// ---------- recording wrappers ----------
+// Live input is ignored during playback (Esc still quits) so runs stay identical.
+static void onKeyboard(unsigned char key, int x, int y) {
+    if (inputReplayIsPlaying()) { if (key == 27) std::exit(0); return; }
+    record(EV_KEY, key, x, y, 0);
+    if (gHandlers.keyboard) gHandlers.keyboard(key, x, y);
+}
+static void onSpecial(int key, int x, int y) {
+    if (inputReplayIsPlaying()) return;
+    record(EV_SPECIAL, 0, x, y, key);
+    if (gHandlers.special) gHandlers.special(key, x, y);
+}
+static void onMouse(int button, int state, int x, int y) {
+    if (inputReplayIsPlaying()) return;
+    record(EV_MOUSE, button, x, y, state);
+    if (gHandlers.mouse) gHandlers.mouse(button, state, x, y);
+}
+static void onMotion(int x, int y) {
+    if (inputReplayIsPlaying()) return;
+    record(EV_MOTION, 0, x, y, 0);
+    if (gHandlers.motion) gHandlers.motion(x, y);
+}
+static void onWheel(int wheel, int direction, int x, int y) {
+    if (inputReplayIsPlaying()) return;
+    record(EV_WHEEL, wheel, x, y, direction);
+    if (gHandlers.wheel) gHandlers.wheel(wheel, direction, x, y);
+}
+static void onMenu(int value) {
+    if (inputReplayIsPlaying()) return;
+    record(EV_MENU, 0, 0, 0, value);
+    if (gHandlers.menu) gHandlers.menu(value);
+}
+
+void installInputCallbacks(const InputReplayHandlers& handlers) {
+    gHandlers = handlers;
+    gRecordStartMs = glutGet(GLUT_ELAPSED_TIME);
+    glutKeyboardFunc(onKeyboard);
+    glutSpecialFunc(onSpecial);
+    glutMouseFunc(onMouse);
+    glutMotionFunc(onMotion);
+    glutMouseWheelFunc(onWheel);
+}
+
+int createInputMenu() { return glutCreateMenu(onMenu); }
+
+// ---------- playback ----------
+static void dispatch(const InputEvent& e) {
+    switch (e.type) {
+    case EV_KEY:     if (gHandlers.keyboard) gHandlers.keyboard(e.a, e.x, e.y); break;
+    case EV_SPECIAL: if (gHandlers.special)  gHandlers.special(e.b, e.x, e.y); break;
+    case EV_MOUSE:   if (gHandlers.mouse)    gHandlers.mouse(e.a, e.b, e.x, e.y); break;
+    case EV_MOTION:  if (gHandlers.motion)   gHandlers.motion(e.x, e.y); break;
+    case EV_WHEEL:   if (gHandlers.wheel)    gHandlers.wheel(e.a, e.b, e.x, e.y); break;
+    case EV_MENU:    if (gHandlers.menu)     gHandlers.menu(e.b); break;
+    default: break;
+    }
+}
+
+void inputReplayBeginFrame() {
+    if (!inputReplayIsPlaying()) return;
+
+    gFrameStart = Clock::now();
+    if (gFrame == 0) gPlayStart = gFrameStart;
+
+    // inject everything that happened up to the end of this simulated frame
+    const double simMs = (gFrame + 1) * gInputReplay.fixedDt * 1000.0;
+    while (gNextEvent < gEvents.size() && gEvents[gNextEvent].timeMs <= simMs)
+        dispatch(gEvents[gNextEvent++]);
+}
+
+float inputReplayFrameDt(float realDt) {
+    return inputReplayIsPlaying() ? gInputReplay.fixedDt : realDt;
+}
+
+void inputReplayEndFrame() {
+    if (!inputReplayIsPlaying()) return;
+
+    const double ms = std::chrono::duration<double, std::milli>(Clock::now() - gFrameStart).count();
+    if (ms < gFrameMin) gFrameMin = ms;
+    if (ms > gFrameMax) gFrameMax = ms;
+    ++gFrame;
+
+    const double simMs = gFrame * gInputReplay.fixedDt * 1000.0;
+    if (gNextEvent >= gEvents.size() && simMs >= gEndTimeMs) {
+        report();
+        std::exit(0);
+    }
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include <GL/freeglut.h>
+
+// Input recording / deterministic replay for benchmarking.
+//
+//   assignment --record session.nzi [--seed N]   record every input event
+//   assignment --replay session.nzi              feed it back, fixed timestep,
+//                                                as fast as possible, then
+//                                                print frame timings and exit
+//
+// The log is a small header (magic, version, RNG seed) followed by fixed
+// 12-byte little-endian event records stamped with milliseconds since start.
+
+enum InputReplayMode {
+    REPLAY_OFF = 0,
+    REPLAY_RECORDING = 1,
+    REPLAY_PLAYING = 2
+};
+
+// The real input handlers; replay calls these directly.
+struct InputReplayHandlers {
+    void (*keyboard)(unsigned char key, int x, int y) = nullptr;
+    void (*special)(int key, int x, int y) = nullptr;
+    void (*mouse)(int button, int state, int x, int y) = nullptr;
+    void (*motion)(int x, int y) = nullptr;
+    void (*wheel)(int wheel, int direction, int x, int y) = nullptr;
+    void (*menu)(int value) = nullptr;
+};
+
+struct InputReplayState {
+    InputReplayMode mode = REPLAY_OFF;
+    int   seed = 1337;               // rand() + background RNG seed
+    float fixedDt = 1.0f / 60.0f;    // simulated seconds per replayed frame
+};
+
+extern InputReplayState gInputReplay;
+
+// Strips --record/--replay/--seed from argv. Call after glutInit().
+void parseInputReplayArgs(int& argc, char** argv);
+
+// Reseeds rand() and returns the seed the background should use.
+int  inputReplaySeed();
+
+// Registers the GLUT input callbacks (wrapped so they can be recorded).
+void installInputCallbacks(const InputReplayHandlers& handlers);
+
+// glutCreateMenu with the recording wrapper around handlers.menu; call after
+// installInputCallbacks.
+int  createInputMenu();
+
+// Per-frame hooks for display(): inject due events / pick the frame dt.
+void  inputReplayBeginFrame();
+float inputReplayFrameDt(float realDt);
+void  inputReplayEndFrame();
+
+inline bool inputReplayIsPlaying() { return gInputReplay.mode == REPLAY_PLAYING; }
@@ -0,0 +1,192 @@
+#include "jobPool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct JobPool {
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;     // a new job (or quit) was posted
+    std::condition_variable idle;     // the last worker left the current job
+    unsigned generation = 0;          // bumped per job so workers never run one twice
+    int  busy = 0;                    // workers still inside the current job
+    bool quit = false;
+
+    // current job (written before the generation bump, read-only while it runs)
+    JobRangeFn fn = nullptr;
+    void* user = nullptr;
+    int count = 0, chunk = 1, chunks = 0;
+    std::atomic<int> nextChunk{ 0 };
+
+    ~JobPool() { stop(); }
+
+    void runChunks() {
+        for (;;) {
+            const int c = nextChunk.fetch_add(1);
+            if (c >= chunks) return;
+            const int begin = c * chunk;
+            fn(begin, std::min(begin + chunk, count), user);
+        }
+    }
+
+    // `seen` starts at the generation current when the worker was started,
+    // so a restarted pool never reruns the last (long gone) job
+    void workerMain(unsigned seen) {
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [&] { return quit || generation != seen; });
+                if (quit) return;
+                seen = generation;
+            }
+            runChunks();
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--busy == 0) idle.notify_one();
+        }
+    }
+
+    void start(int threads) {
+        std::lock_guard<std::mutex> lock(mutex);
+        const unsigned current = generation;
+        for (int i = 1; i < threads; ++i)
+            workers.emplace_back([this, current] { workerMain(current); });
+    }
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            quit = true;
+        }
+        wake.notify_all();
+        for (std::thread& t : workers) t.join();
+        workers.clear();
+        quit = false;
+    }
+};
+
+JobPool gJobs;
+int gJobThreads = 0;   // 0 = not started yet
+
+// Background jobs get their own threads (one fewer than the hardware
+// threads, so the GL thread keeps a core) and a plain FIFO.
+struct BackgroundQueue {
+    struct Job { BackgroundJobFn fn; void* user; };
+
+    std::vector<std::thread> threads;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::deque<Job> jobs;
+    bool quit = false;                // set once by stop(); later submits are dropped
+
+    ~BackgroundQueue() { stop(); }   // backstop only: the app stops it from atexit
+
+    // Drop the queued jobs and wait for the running ones to finish
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            quit = true;
+            jobs.clear();
+        }
+        wake.notify_all();
+        for (std::thread& t : threads) t.join();
+        threads.clear();
+    }
+
+    void threadMain() {
+        for (;;) {
+            Job job;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [&] { return quit || !jobs.empty(); });
+                if (quit) return;
+                job = jobs.front();
+                jobs.pop_front();
+            }
+            job.fn(job.user);
+        }
+    }
+
+    void submit(BackgroundJobFn fn, void* user) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (quit) return;
+            if (threads.empty()) {
+                const unsigned hw = std::thread::hardware_concurrency();
+                const int count = hw > 1 ? (int)hw - 1 : 1;
+                for (int i = 0; i < count; ++i)
+                    threads.emplace_back([this] { threadMain(); });
+            }
+            jobs.push_back(Job{ fn, user });
+        }
+        wake.notify_one();
+    }
+};
+
+BackgroundQueue gBackground;
+
+void ensureStarted() {
+    if (gJobThreads > 0) return;
+    const unsigned hw = std::thread::hardware_concurrency();
+    gJobThreads = hw ? (int)hw : 1;
+    gJobs.start(gJobThreads);
+}
+
+} // namespace
+
+int jobThreadCount() {
+    ensureStarted();
+    return gJobThreads;
+}
+
+void setJobThreadCount(int threads) {
+    if (threads < 1) threads = 1;
+    if (threads == gJobThreads) return;
+    gJobs.stop();
+    gJobThreads = threads;
+    gJobs.start(threads);
+}
+
+void parallelFor(int count, int chunk, JobRangeFn fn, void* user) {
+    if (count <= 0) return;
+    if (chunk < 1) chunk = 1;
+    const int chunks = (count + chunk - 1) / chunk;
+
+    ensureStarted();
+    if (chunks == 1 || gJobs.workers.empty()) {
+        for (int begin = 0; begin < count; begin += chunk)
+            fn(begin, std::min(begin + chunk, count), user);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(gJobs.mutex);
+        gJobs.fn = fn;
+        gJobs.user = user;
+        gJobs.count = count;
+        gJobs.chunk = chunk;
+        gJobs.chunks = chunks;
+        gJobs.nextChunk.store(0);
+        gJobs.busy = (int)gJobs.workers.size();
+        ++gJobs.generation;
+    }
+    gJobs.wake.notify_all();
+
+    gJobs.runChunks();
+
+    std::unique_lock<std::mutex> lock(gJobs.mutex);
+    gJobs.idle.wait(lock, [] { return gJobs.busy == 0; });
+}
+
+void submitBackgroundJob(BackgroundJobFn fn, void* user) {
+    gBackground.submit(fn, user);
+}
+
+void stopBackgroundJobs() {
+    gBackground.stop();
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+// ---------------- Job pool ----------------
+// A handful of persistent worker threads for data-parallel loops. Work is
+// cut into fixed-size chunks [begin, end) that callers must treat as
+// disjoint: a chunk may only write the elements it owns, so jobs need no
+// locks. The calling thread works on chunks too and parallelFor returns
+// once every chunk is done. Call from the main thread only (not re-entrant).
+
+typedef void (*JobRangeFn)(int begin, int end, void* user);
+
+// Runs fn over [0, count) in chunks of `chunk`. A single chunk (or a pool of
+// one thread) runs inline, so small loops pay nothing for the option.
+void parallelFor(int count, int chunk, JobRangeFn fn, void* user);
+
+// Threads taking part in parallelFor, including the caller (1 = serial).
+// Defaults to the hardware thread count; workers start on first use.
+int  jobThreadCount();
+void setJobThreadCount(int threads);
+
+// ---------------- Background jobs ----------------
+// Fire-and-forget tasks (asset decoding) that run on their own threads
+// alongside frames, so a long task never holds up a parallelFor. Jobs start
+// in submission order; the job hands its result back itself (e.g. through a
+// locked queue the main thread drains). Submit from any thread.
+typedef void (*BackgroundJobFn)(void* user);
+void submitBackgroundJob(BackgroundJobFn fn, void* user);
+
+// Shutdown: cancel the queued jobs and join the threads once the running
+// ones return. Register with atexit before the first submit, so it runs
+// while the statics those jobs touch (in other files) are still alive.
+void stopBackgroundJobs();
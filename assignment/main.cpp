@@ -2,6 +2,8 @@
 #include <GL/freeglut.h>
 #include <cstdlib>
 #include <cmath>
+#include <chrono>
+#include <cstdio>
 
 #include "utils.hpp"
 #include "model.hpp"
@@ -13,12 +15,24 @@
 #include "cannon.hpp"
 #include "customization.hpp"
 #include "nezha_bg.hpp"   // <-- Nezha background
+#include "framePacing.hpp"
+#include "inputReplay.hpp"
 
 // Animations & extras
 #include "animation.hpp"
 #include "prayAnimation.hpp"
 #include "flower.hpp"
 #include "meditation.hpp"
+#include "animScheduler.hpp"
+#include "particles.hpp"
+#include "particleStress.hpp"
+#include "transparentPass.hpp"
+#include "batch2D.hpp"
+#include "backgroundDiff.hpp"
+#include "textureStreaming.hpp"
+#include "textureAtlas.hpp"
+#include "assetPack.hpp"
+#include "jobPool.hpp"
 
 // ===============================
 // Controls UI (overlay + menu)
@@ -63,7 +77,13 @@ namespace ControlsUI {
             "Animations:",
             "  7: Fire Dragon Coil   8: Kung Fu Kick + Flower  9: Meditation",
             "",
-            "P: print primitive counts    Right-click: quick menu    Esc/Q: quit",
+            "P: print primitive counts + active animations",
+            "Right-click: quick menu      Esc/Q: quit",
+            "F1: toggle this help         F2: toggle frame pacing",
+            "F3: background embers x4 (60 .. 15360)",
+            "F4: particles on compute shader / CPU",
+            "F5: background as one fullscreen shader / geometry",
+            "F6: background clouds every frame / cached at 30, 15, 5 Hz",
             "=========================================="
         };
         const int N = int(sizeof(L) / sizeof(L[0]));
@@ -87,13 +107,9 @@ namespace ControlsUI {
         const float y1 = H - 10.0f;
         const float y0 = y1 - h;
 
-        glColor4f(0.06f, 0.08f, 0.12f, 0.82f);
-        glBegin(GL_QUADS);
-        glVertex2f(x0, y0);
-        glVertex2f(x0 + w, y0);
-        glVertex2f(x0 + w, y1);
-        glVertex2f(x0, y1);
-        glEnd();
+        const float panel[4] = { 0.06f, 0.08f, 0.12f, 0.82f };
+        batch2DQuad(BLEND_ALPHA, x0, y0, x0 + w, y1, panel, panel);
+        batch2DFlush();
 
         glColor3f(1, 1, 1);
         drawBitmapText(x0 + pad, y1 - pad - 4, "Controls");
@@ -108,6 +124,11 @@ namespace ControlsUI {
 
     static void onSpecial(int key) {
         if (key == GLUT_KEY_F1) { show = !show; glutPostRedisplay(); }
+        if (key == GLUT_KEY_F2) toggleFramePacing();
+        if (key == GLUT_KEY_F3) { cycleNezhaEmberCount(); glutPostRedisplay(); }
+        if (key == GLUT_KEY_F4) { toggleGpuParticles(); glutPostRedisplay(); }
+        if (key == GLUT_KEY_F5) { toggleNezhaShaderBackground(); glutPostRedisplay(); }
+        if (key == GLUT_KEY_F6) { cycleNezhaSlowLayerHz(); glutPostRedisplay(); }
     }
     static void onReshape(int w, int h) { W = w; H = (h == 0 ? 1 : h); }
 
@@ -127,7 +148,7 @@ namespace ControlsUI {
         glutPostRedisplay();
     }
     static void initMenu() {
-        int m = glutCreateMenu(onMenu);
+        int m = createInputMenu();   // entries are recorded like keys
         glutAddMenuEntry("Toggle cannon (C)", 1);
         glutAddMenuEntry("Fire cannon (V)", 2);
         glutAddMenuEntry("Toggle weapon (3)", 3);
@@ -142,6 +163,7 @@ namespace ControlsUI {
 }
 static void ControlsUI_DrawOverlay() { ControlsUI::drawOverlay(); }
 static void ControlsUI_OnSpecial(int k, int, int) { ControlsUI::onSpecial(k); }
+static void ControlsUI_OnMenu(int id) { ControlsUI::onMenu(id); }
 static void ControlsUI_OnReshape(int w, int h) { ControlsUI::onReshape(w, h); }
 static void ControlsUI_Init() { ControlsUI::initMenu(); }
 
@@ -305,15 +327,56 @@ static void drawCharacter() {
 
     glPopMatrix(); // character root
 
-    // VFX outside character transform
-    drawFireWheels();
-    drawFireDragon();
+    // VFX outside character transform (wheels/dragon, only while running)
+    drawScheduledCharacterEffects();
 }
 
 // ===============================
 // Display / reshape / input
 // ===============================
+static std::chrono::steady_clock::time_point gLaunchTime;   // for time-to-first-frame
+
+// Every texture file the app loads (also what --pack puts in the asset pack)
+enum TextureLoad {
+    TEX_STREAMED,     // decoded on the background jobs at startup
+    TEX_ATLAS,        // streamed, and also packed into the character atlas
+    TEX_LAZY,         // only some animations draw it: loaded on first use or prefetch
+};
+struct TextureFile {
+    GLuint* tex;
+    const char* path;
+    TextureLoad load;
+};
+static const TextureFile kTextureFiles[] = {
+    // Fur, belt, ribbons, weapon, bamboo, bronze
+    { &gTex.pandaWhite,  "textures/panda_white_fur.bmp",   TEX_ATLAS },
+    { &gTex.pandaBlack,  "textures/panda_black_fur.bmp",   TEX_ATLAS },
+    { &gTex.goldBelt,    "textures/gold_belt.bmp",         TEX_ATLAS },
+    { &gTex.redSilk,     "textures/red_silk_ribbon.bmp",   TEX_STREAMED },
+    { &gTex.blade,       "textures/sword_blade.bmp",       TEX_STREAMED },
+    { &gTex.bamboo,      "textures/bamboo_boom.bmp",       TEX_STREAMED },
+    { &gTex.bronze,      "textures/bronze_bullet.bmp",     TEX_STREAMED },
+
+    // Shirt textures
+    { &gTex.redShirt,    "textures/red_silk_shirt.bmp",    TEX_ATLAS },
+    { &gTex.orangeShirt, "textures/orange_silk_shirt.bmp", TEX_ATLAS },
+    { &gTex.blueShirt,   "textures/blue_silk_shirt.bmp",   TEX_ATLAS },
+    { &gTex.goldShirt,   "textures/gold_silk_shirt.bmp",   TEX_ATLAS },
+
+    // Sampled every frame by the head reflection, so loaded up front
+    { &gTex.cloud,       "textures/cloud_texture.bmp",     TEX_STREAMED },
+
+    // Optional extras
+    { &gTex.dragon,      "textures/dragon_skin.bmp",       TEX_LAZY },
+    { &gTex.lotus,       "textures/lotus_petal.bmp",       TEX_LAZY },
+};
+static const int kTextureFileCount = (int)(sizeof(kTextureFiles) / sizeof(kTextureFiles[0]));
+
 void display() {
+    framePacingBeginFrame();
+    inputReplayBeginFrame();   // replay: inject the events due this frame
+    uploadStreamedTextures();  // textures decoded since the last frame
+    uploadTextureAtlas();
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
     // --- Background timing and draw (2D overlay) ---
@@ -322,6 +385,7 @@ void display() {
     float dt = (prevMs == 0) ? 0.016f : (curMs - prevMs) * 0.001f;
     if (dt > 0.05f) dt = 0.05f;
     prevMs = curMs;
+    dt = inputReplayFrameDt(dt); // fixed timestep while replaying
 
     updateNezhaBackground(dt);
     drawNezhaBackground();
@@ -331,15 +395,8 @@ void display() {
     glMatrixMode(GL_MODELVIEW);
     glLoadIdentity();
 
-    // Animation updates
-    updateCannonAnimation();
-    updateShootingAnimation();
-    updateAnimations();
-    updateRightLegLiftAnimation();
-    updateRightStraightLegLift();
-    updateKungFuKickAnimation();
-    updateFlowerBloomAnimation();
-    updateMeditationAnimation();
+    // Animation updates (only systems that are currently running)
+    updateScheduledAnimations();
 
     // Camera
     const double cx = camDist * std::cos(deg2rad(camPitch)) * std::sin(deg2rad(camYaw));
@@ -385,9 +442,10 @@ void display() {
     drawCharacter();
 
     // Flower/lotus/particles at feet
-    drawFlowerBloomAt(0.0f, -1.50f + 0.02f, 0.0f);
-    drawLotusPlatform(0.0f, -1.50f, 0.0f);
-    drawMeditationParticles(0.0f, -1.50f, 0.0f);
+    drawScheduledGroundEffects(0.0f, -1.50f, 0.0f);
+
+    // Everything blended, back to front, after the opaque scene
+    flushTransparentPass();
 
     // In-game help
     ControlsUI_DrawOverlay();
@@ -400,6 +458,17 @@ void display() {
     }
 
     glutSwapBuffers();
+
+    if (frameCount == 1) {
+        const double ms = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - gLaunchTime).count();
+        std::printf("First frame %.1f ms after launch (%d texture(s) still streaming)\n",
+            ms, pendingStreamedTextures());
+    }
+
+    // Decide when the next frame is needed (or sleep until input)
+    inputReplayEndFrame();
+    framePacingEndFrame();
 }
 
 void reshape(int w, int h) {
@@ -409,6 +478,7 @@ void reshape(int w, int h) {
     glLoadIdentity();
     gluPerspective(50.0, (float)w / h, 0.1, 100.0);
 
+    resizeNezhaBackground(w, h);
     ControlsUI_OnReshape(w, h);
 }
 
@@ -435,7 +505,10 @@ void keyboard(unsigned char key, int, int) {
     case '9': triggerMeditation(); break;
 
         // Polygon count
-    case 'p': case 'P': PolygonCounter::printToConsole(); PrimitiveCounter::printToConsole(); break;
+    case 'p': case 'P':
+        PolygonCounter::printToConsole(); PrimitiveCounter::printToConsole(); printAnimSchedulerStats();
+        std::printf("Transparent pass: %d item(s) last frame\n", transparentItemsLastFrame());
+        break;
     }
     glutPostRedisplay();
 }
@@ -465,13 +538,25 @@ void mouseWheel(int, int direction, int, int) {
     glutPostRedisplay();
 }
 
-void idle() { glutPostRedisplay(); }
-
 // ===============================
 // Main
 // ===============================
 int main(int argc, char** argv) {
+    gLaunchTime = std::chrono::steady_clock::now();
     glutInit(&argc, argv);
+    parseInputReplayArgs(argc, argv);   // --record / --replay / --seed
+    parseAnimationArgs(argc, argv);     // --dragon-at <seconds> / --fire-density <n>
+    parseParticleStressArgs(argc, argv); // --stress / --threads <n>
+    parseBackgroundDiffArgs(argc, argv); // --bg-diff
+    parseAssetPackArgs(argc, argv);     // --pack [file]
+
+    // --pack: bake every texture into the asset pack and exit
+    {
+        const char* files[kTextureFileCount];
+        for (int i = 0; i < kTextureFileCount; ++i) files[i] = kTextureFiles[i].path;
+        if (runAssetPackerIfRequested(files, kTextureFileCount)) return assetPackerExitCode();
+    }
+
     glutInitDisplayMode(GLUT_DOUBLE | GLUT_RGB | GLUT_DEPTH);
     glutInitWindowSize(960, 720);
     glutCreateWindow("BMCS2173 Character (modular)");
@@ -531,44 +616,54 @@ int main(int argc, char** argv) {
     // Texturing init (Multi-Byte loader)
     startGDIplus();
     atexit(stopGDIplus);
+    atexit(stopBackgroundJobs);   // runs first: no decode job outlives the texture queues
     glEnable(GL_TEXTURE_2D);
     glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
 
-    // Fur, belt, ribbons, weapon, bamboo, bronze
-    gTex.pandaWhite = loadTexture2D("textures/panda_white_fur.bmp");
-    gTex.pandaBlack = loadTexture2D("textures/panda_black_fur.bmp");
-    gTex.goldBelt = loadTexture2D("textures/gold_belt.bmp");
-    gTex.redSilk = loadTexture2D("textures/red_silk_ribbon.bmp");
-    gTex.blade = loadTexture2D("textures/sword_blade.bmp");
-    gTex.bamboo = loadTexture2D("textures/bamboo_boom.bmp");
-    gTex.bronze = loadTexture2D("textures/bronze_bullet.bmp");
-
-    // Shirt textures
-    gTex.redShirt = loadTexture2D("textures/red_silk_shirt.bmp");
-    gTex.orangeShirt = loadTexture2D("textures/orange_silk_shirt.bmp");
-    gTex.blueShirt = loadTexture2D("textures/blue_silk_shirt.bmp");
-    gTex.goldShirt = loadTexture2D("textures/gold_silk_shirt.bmp");
-
-    // Optional extras
-    gTex.dragon = loadTexture2D("textures/dragon_skin.bmp");
-    gTex.lotus = loadTexture2D("textures/lotus_petal.bmp");
-    gTex.cloud = loadTexture2D("textures/cloud_texture.bmp");
+    // Textures come from the asset pack when there is one (mapped, uploaded
+    // in place), else the loose files are decoded on the background jobs;
+    // either way the first frames draw with placeholders.
+    openAssetPack(assetPath("assets.pack").c_str());
+    for (int i = 0; i < kTextureFileCount; ++i) {
+        const TextureFile& t = kTextureFiles[i];
+        *t.tex = t.load == TEX_LAZY ? lazyTexture2D(t.path) : streamTexture2D(t.path);
+        // character pieces that sample in [0,1] (fur spheres, belt and cuff
+        // bands) share one atlas; the same textures keep tiling elsewhere
+        if (t.load == TEX_ATLAS) addToTextureAtlas(*t.tex, t.path);
+    }
+    streamTextureAtlas();
 
     // Pick a starting shirt (also sets sword/outfit color)
     setShirtStyle(SHIRT_RED);
 
-    // Nezha background init
-    initNezhaBackground(1337);
+    // Nezha background init (seed also reseeds rand(), fixed for replays)
+    initNezhaBackground(inputReplaySeed());
+
+    // --stress: benchmark particle counts and exit instead of running the app
+    if (runParticleStressIfRequested()) return 0;
+
+    // --bg-diff: compare the shader background against the geometry one and exit
+    if (runBackgroundDiffIfRequested()) return backgroundDiffExitCode();
 
     // Callbacks
     glutDisplayFunc(display);
     glutReshapeFunc(reshape);
-    glutKeyboardFunc(keyboard);
-    glutSpecialFunc(ControlsUI_OnSpecial);   // F1 toggle for help
-    glutMouseFunc(mouse);
-    glutMotionFunc(mouseMotion);
-    glutMouseWheelFunc(mouseWheel);
-    glutIdleFunc(idle);
+
+    // Input (routed through the recorder so sessions can be replayed)
+    InputReplayHandlers input;
+    input.keyboard = keyboard;
+    input.special = ControlsUI_OnSpecial;   // F1 toggle for help
+    input.mouse = mouse;
+    input.motion = mouseMotion;
+    input.wheel = mouseWheel;
+    input.menu = ControlsUI_OnMenu;
+    installInputCallbacks(input);
+
+    // Cannon barrel settles to its rest angle on startup
+    scheduleAnimation(ANIMSYS_CANNON);
+
+    // Redraw only while something moves (replaces an always-on idle redraw)
+    initFramePacing();
 
     // Right-click menu
     ControlsUI_Init();
@@ -0,0 +1,68 @@
+#include "mappedFile.hpp"
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+
+bool openMappedFile(MappedFile& f, const char* path) {
+    closeMappedFile(f);
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) { CloseHandle(file); return false; }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    const void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view) {
+        if (mapping) CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    f.file = file;
+    f.mapping = mapping;
+    f.data = (const unsigned char*)view;
+    f.size = (size_t)size.QuadPart;
+    return true;
+}
+
+void closeMappedFile(MappedFile& f) {
+    if (f.data) UnmapViewOfFile(f.data);
+    if (f.mapping) CloseHandle((HANDLE)f.mapping);
+    if (f.file) CloseHandle((HANDLE)f.file);
+    f = MappedFile();
+}
+
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+bool openMappedFile(MappedFile& f, const char* path) {
+    closeMappedFile(f);
+    const int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) { close(fd); return false; }
+
+    void* view = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (view == MAP_FAILED) { close(fd); return false; }
+    madvise(view, (size_t)st.st_size, MADV_SEQUENTIAL);
+
+    f.fd = fd;
+    f.data = (const unsigned char*)view;
+    f.size = (size_t)st.st_size;
+    return true;
+}
+
+void closeMappedFile(MappedFile& f) {
+    if (f.data) munmap((void*)f.data, f.size);
+    if (f.fd >= 0) close(f.fd);
+    f = MappedFile();
+}
+#endif
@@ -0,0 +1,21 @@
+#pragma once
+#include <cstddef>
+
+// ---------------- Memory-mapped files ----------------
+// Read-only view of a whole file (mmap on POSIX, a file mapping on
+// Windows), so loaders can parse assets in place instead of reading them
+// into a heap copy first. The view stays valid until closeMappedFile.
+
+struct MappedFile {
+    const unsigned char* data = nullptr;
+    size_t size = 0;
+#if defined(_WIN32)
+    void* file = nullptr;       // HANDLE
+    void* mapping = nullptr;    // HANDLE
+#else
+    int fd = -1;
+#endif
+};
+
+bool openMappedFile(MappedFile& f, const char* path);   // false if missing or empty
+void closeMappedFile(MappedFile& f);
@@ -1,5 +1,11 @@
 #include "meditation.hpp"
 #include "utils.hpp"
+#include "easing.hpp"
+#include "animScheduler.hpp"
+#include "particles.hpp"
+#include "meshInstancing.hpp"
+#include "transparentPass.hpp"
+#include "impostors.hpp"
 #include <GL/freeglut.h>
 #include <cmath>
 #include <algorithm>
@@ -17,17 +23,36 @@
 
 MeditationState meditation;
 
-static inline float smooth01(float t) { return t * t * (3.0f - 2.0f * t); }
-static inline float smoothstep(float edge0, float edge1, float x) {
-    float t = (x - edge0) / (edge1 - edge0);
-    t = std::max(0.0f, std::min(1.0f, t));
-    return t * t * (3.0f - 2.0f * t);
-}
+// Pose channels that scale with the settle-in phase, and their full values
+static float MeditationState::* const kPoseChannels[] = {
+    &MeditationState::armPose,                 // arms raise forward (invert)
+    &MeditationState::leftArmLift,             // left arm lifts up high
+    &MeditationState::leftHandBendBack,        // left hand bends backward
+    &MeditationState::leftLegBend,             // inward
+    &MeditationState::rightLegBend,            // outward (opposite)
+    &MeditationState::leftFootRotate,
+    &MeditationState::rightFootRotate,
+    &MeditationState::leftPantsBend,
+    &MeditationState::rightPantsBend
+};
+static const int kPoseChannelCount = int(sizeof(kPoseChannels) / sizeof(kPoseChannels[0]));
+static const float kFullPose[kPoseChannelCount] = {
+    -45.0f, 90.0f, 60.0f, -40.0f, 40.0f, 45.0f, -45.0f, -65.0f, 65.0f
+};
+
+// Prayer hands: leftHandSpread, rightHandSpread, handTouch
+static float MeditationState::* const kPrayerChannels[3] = {
+    &MeditationState::leftHandSpread, &MeditationState::rightHandSpread, &MeditationState::handTouch
+};
+static const float kPrayerOpen[3] = { 0.0f, 0.0f, 0.0f };
+static const float kPrayerSpread[3] = { 60.0f, 60.0f, 0.0f };
+static const float kPrayerTouch[3] = { 0.0f, 0.0f, 30.0f };
 
 void triggerMeditation() {
     meditation = MeditationState{};
     meditation.isActive = true;
     meditation.time = 0.0f;
+    scheduleAnimation(ANIMSYS_MEDITATION);
 }
 
 void updateMeditationAnimation() {
@@ -52,13 +77,15 @@ void updateMeditationAnimation() {
     meditation.meditationHeight = 0.0f;              // yours: keep planted
 #endif
 
-    meditation.meditationBob = 0.05f * std::sinf(meditation.time * 2.0f); // gentle bobbing
-    meditation.armPose = posePhase * -45.0f;  // arms raise forward (invert)
-    meditation.headTilt = 0.1f * std::sinf(meditation.time * 1.5f);  // subtle head movement
+    meditation.meditationBob = 0.05f * std::sin(meditation.time * 2.0f); // gentle bobbing
+    meditation.headTilt = 0.1f * std::sin(meditation.time * 1.5f);  // subtle head movement
 
-    // ---------- Friend extras: left arm & hand ----------
-    meditation.leftArmLift = posePhase * 90.0f;  // left arm lifts up high
-    meditation.leftHandBendBack = posePhase * 60.0f;  // left hand bends backward
+    // ---------- Arms, left hand, cross-legged legs & pants follow ----------
+    {
+        float pose[kPoseChannelCount];
+        scaleN(kFullPose, posePhase, pose, kPoseChannelCount);
+        for (int i = 0; i < kPoseChannelCount; ++i) meditation.*kPoseChannels[i] = pose[i];
+    }
 
     // ---------- Eye close / open cycle (3s loop) ----------
     {
@@ -71,43 +98,19 @@ void updateMeditationAnimation() {
     // ---------- Prayer-hand cycle (4s): spread -> hold -> together -> hold ----------
     {
         float prayerPhase = std::fmod(meditation.time * 0.5f, 4.0f); // 0..4
-        if (prayerPhase < 1.0f) {
-            float spreadT = prayerPhase;       // 0..1
-            meditation.leftHandSpread = spreadT * 60.0f;
-            meditation.rightHandSpread = spreadT * 60.0f;
-            meditation.handTouch = 0.0f;
-        }
-        else if (prayerPhase < 2.0f) {
-            meditation.leftHandSpread = 60.0f;
-            meditation.rightHandSpread = 60.0f;
-            meditation.handTouch = 0.0f;
-        }
-        else if (prayerPhase < 3.0f) {
-            float touchT = (prayerPhase - 2.0f);  // 0..1
-            meditation.leftHandSpread = 60.0f * (1.0f - touchT);
-            meditation.rightHandSpread = 60.0f * (1.0f - touchT);
-            meditation.handTouch = touchT * 30.0f; // move toward center
-        }
-        else {
-            meditation.leftHandSpread = 0.0f;
-            meditation.rightHandSpread = 0.0f;
-            meditation.handTouch = 30.0f;         // hold together
-        }
+        float hands[3];
+        if (prayerPhase < 1.0f)      lerpN(kPrayerOpen, kPrayerSpread, prayerPhase, hands, 3);
+        else if (prayerPhase < 2.0f) std::copy(kPrayerSpread, kPrayerSpread + 3, hands);
+        else if (prayerPhase < 3.0f) lerpN(kPrayerSpread, kPrayerTouch, prayerPhase - 2.0f, hands, 3);
+        else                         std::copy(kPrayerTouch, kPrayerTouch + 3, hands); // hold together
+        for (int i = 0; i < 3; ++i) meditation.*kPrayerChannels[i] = hands[i];
     }
 
-    // ---------- Legs (cross-legged) & pants follow ----------
-    meditation.leftLegBend = -posePhase * 40.0f;   // inward
-    meditation.rightLegBend = posePhase * 40.0f;   // outward (opposite)
-    meditation.leftFootRotate = posePhase * 45.0f;
-    meditation.rightFootRotate = -posePhase * 45.0f;
-    meditation.leftPantsBend = -posePhase * 65.0f;
-    meditation.rightPantsBend = posePhase * 65.0f;
-
     // ---------- Platform / petals ----------
     meditation.platformRotate += dt * 15.0f; // deg/sec
-    meditation.platformPulse = 0.3f + 0.2f * std::sinf(meditation.time * 3.0f);
-    meditation.platformGlow = 0.6f + 0.4f * std::sinf(meditation.time * 2.5f);
-    meditation.petalGlow = 0.4f + 0.6f * std::sinf(meditation.time * 4.0f);
+    meditation.platformPulse = 0.3f + 0.2f * std::sin(meditation.time * 3.0f);
+    meditation.platformGlow = 0.6f + 0.4f * std::sin(meditation.time * 2.5f);
+    meditation.petalGlow = 0.4f + 0.6f * std::sin(meditation.time * 4.0f);
 
     // ---------- Particles ----------
     if (meditation.time > 1.0f) {
@@ -119,104 +122,136 @@ void updateMeditationAnimation() {
     }
 }
 
-void drawLotusPlatform(float x, float y, float z) {
-    if (!meditation.isActive) return;
-
-    glPushAttrib(GL_ENABLE_BIT | GL_CURRENT_BIT | GL_LIGHTING_BIT);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glDisable(GL_LIGHTING);
-
-    // Base (slightly scaled sphere)
-    glPushMatrix();
-    glTranslatef(x, y, z);
-    glRotatef(meditation.platformRotate, 0, 1, 0);
-    glColor4f(0.8f, 0.9f, 1.0f, 0.7f * meditation.platformGlow);
-    glScalef(1.2f, 0.1f, 1.2f);
-    glutSolidSphere(1.0, 24, 12);
-    glPopMatrix();
+// Petals: cached sphere mesh drawn as 8 + 12 + 16 instances per frame.
+// Base and core glow are impostors (camera-facing cloud puffs).
+static InstancedMesh gLotusPetalMesh;
+static const int kLotusPetalCount = 8 + 12 + 16;
+static MeshInstance gLotusPetals[kLotusPetalCount];
 
-    // Lotus petals (3 layers)
-    glPushMatrix();
-    glTranslatef(x, y + 0.05f, z);
-    glRotatef(meditation.platformRotate, 0, 1, 0);
+// Layer colours: warm white, light purple, light blue (alpha before glow)
+static const float kLotusLayerColor[3][4] = {
+    { 1.0f, 0.9f, 0.8f, 0.8f }, { 0.9f, 0.8f, 1.0f, 0.7f }, { 0.8f, 0.9f, 1.0f, 0.6f }
+};
 
+static void buildLotusPetalInstances() {
+    int n = 0;
     for (int layer = 0; layer < 3; ++layer) {
-        float layerScale = 0.8f + 0.2f * layer;
-        float layerHeight = 0.02f * layer;
-        int   petals = 8 + layer * 4;
+        const float layerScale = 0.8f + 0.2f * layer;
+        const float layerHeight = 0.02f * layer;
+        const int   petals = 8 + layer * 4;
+        const float petalGlow = meditation.petalGlow * (1.0f - 0.3f * layer);
 
-        glPushMatrix();
-        glTranslatef(0, layerHeight, 0);
-        glScalef(layerScale, 1.0f, layerScale);
+        InstanceXform frame = xformIdentity();
+        xformTranslate(frame, 0, 0.05f + layerHeight, 0);
+        xformScale(frame, layerScale, 1.0f, layerScale);
 
         for (int i = 0; i < petals; ++i) {
-            float angle = (2.0f * float(M_PI) * i) / float(petals);
-            float petalGlow = meditation.petalGlow * (1.0f - 0.3f * layer);
-
-            glPushMatrix();
-            glRotatef(angle * 180.0f / float(M_PI), 0, 1, 0);
-            glTranslatef(0.6f, 0, 0);
-            glRotatef(-15.0f, 0, 0, 1);
-
-            // Colors per layer
-            if (layer == 0)        glColor4f(1.0f, 0.9f, 0.8f, 0.8f * petalGlow); // warm white
-            else if (layer == 1)   glColor4f(0.9f, 0.8f, 1.0f, 0.7f * petalGlow); // light purple
-            else                   glColor4f(0.8f, 0.9f, 1.0f, 0.6f * petalGlow); // light blue
-
-            glScalef(0.4f, 0.15f, 0.8f);
-            glutSolidSphere(1.0, 16, 8);
-            glPopMatrix();
+            const float angle = (2.0f * float(M_PI) * i) / float(petals);
+            MeshInstance& petal = gLotusPetals[n++];
+            petal.xform = frame;
+            xformRotate(petal.xform, angle * 180.0f / float(M_PI), 0, 1, 0);
+            xformTranslate(petal.xform, 0.6f, 0, 0);
+            xformRotate(petal.xform, -15.0f, 0, 0, 1);
+            xformScale(petal.xform, 0.4f, 0.15f, 0.8f);
+            for (int c = 0; c < 3; ++c) petal.rgba[c] = kLotusLayerColor[layer][c];
+            petal.rgba[3] = kLotusLayerColor[layer][3] * petalGlow;
         }
+    }
+}
 
-        glPopMatrix();
+static void drawQueuedLotus(const TransparentItem&) {
+    drawMeshInstances(gLotusPetalMesh, gLotusPetals, kLotusPetalCount, false);
+}
+
+// Aura: a ring of puffs where the flattened base sphere was (radius 1.2),
+// plus the energy core as a single glow above the petals
+static const int kAuraPuffs = 24;
+
+static void queueLotusGlow() {
+    Impostor glow[kAuraPuffs + 1];
+    for (int i = 0; i < kAuraPuffs; ++i) {
+        const float a = (2.0f * float(M_PI) * i) / float(kAuraPuffs);
+        Impostor& p = glow[i];
+        p.x = 0.85f * std::cos(a);
+        p.y = 0.02f;
+        p.z = 0.85f * std::sin(a);
+        p.size = 0.45f + 0.05f * std::sin(meditation.time * 2.0f + i);
+        p.spin = a * 3.0f;
+        p.r = 0.8f; p.g = 0.9f; p.b = 1.0f;
+        p.a = 0.35f * meditation.platformGlow;
     }
+    Impostor& core = glow[kAuraPuffs];
+    core.y = 0.13f;
+    core.size = 0.35f;
+    core.r = 1.0f; core.g = 1.0f; core.b = 0.9f;
+    core.a = 0.9f * meditation.platformPulse;
+    queueImpostors(glow, kAuraPuffs + 1, BLEND_ADDITIVE);
+}
 
-    // Central energy core
+void drawLotusPlatform(float x, float y, float z) {
+    if (!meditation.isActive) return;
+
+    buildSphereMesh(gLotusPetalMesh, 16, 8);
+    buildLotusPetalInstances();
+
+    // whole platform turns together; drawn in the transparent pass
     glPushMatrix();
-    glTranslatef(0, 0.08f, 0);
-    glColor4f(1.0f, 1.0f, 0.9f, 0.9f * meditation.platformPulse);
-    glScalef(0.3f, 0.1f, 0.3f);
-    glutSolidSphere(1.0, 20, 10);
+    glTranslatef(x, y, z);
+    glRotatef(meditation.platformRotate, 0, 1, 0);
+    queueLotusGlow();
+    queueTransparent(0, 0, 0, BLEND_ALPHA, 0, drawQueuedLotus);
     glPopMatrix();
+}
 
-    glPopMatrix();
-    glPopAttrib();
+static void drawQueuedMote(const TransparentItem& item) {
+    glColor4f(0.9f, 0.95f, 1.0f, item.args[0]);
+    glutSolidSphere(0.03, 8, 6);
 }
 
+// Each mote is its own transparent item so it sorts against the platform
+// and the character (they used to draw over everything with depth test off)
 void drawMeditationParticles(float x, float y, float z) {
     if (!meditation.particlesActive) return;
 
-    glPushAttrib(GL_ENABLE_BIT | GL_CURRENT_BIT | GL_DEPTH_BUFFER_BIT);
-    glDisable(GL_LIGHTING);
-    glDisable(GL_DEPTH_TEST);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
     glPushMatrix();
     glTranslatef(x, y + meditation.meditationHeight + 0.5f, z);
 
+    float phase = std::fmod(meditation.particleTime / meditation.particleDuration, 1.0f);
+    float particleAlpha = 0.8f * (1.0f - phase);
+
     const int kCount = 12;
     for (int i = 0; i < kCount; ++i) {
         float angle = (2.0f * float(M_PI) * i) / float(kCount) + meditation.time * 0.5f;
-        float radius = 1.2f + 0.3f * std::sinf(meditation.time * 2.0f + i);
-        float height = 0.5f * std::sinf(meditation.time * 1.5f + i * 0.5f);
+        float radius = 1.2f + 0.3f * std::sin(meditation.time * 2.0f + i);
+        float height = 0.5f * std::sin(meditation.time * 1.5f + i * 0.5f);
 
-        float px = radius * std::cosf(angle);
+        float px = radius * std::cos(angle);
         float py = height;
-        float pz = radius * std::sinf(angle);
+        float pz = radius * std::sin(angle);
 
         glPushMatrix();
         glTranslatef(px, py, pz);
-
-        float phase = std::fmod(meditation.particleTime / meditation.particleDuration, 1.0f);
-        float particleAlpha = 0.8f * (1.0f - phase);
-        glColor4f(0.9f, 0.95f, 1.0f, particleAlpha);
-
-        glutSolidSphere(0.03, 8, 6);
+        queueTransparent(0, 0, 0, BLEND_ALPHA, 0, drawQueuedMote).args[0] = particleAlpha;
         glPopMatrix();
     }
 
     glPopMatrix();
-    glPopAttrib();
+}
+
+bool spawnMeditationParticle(ParticlePool& pool) {
+    ParticleRng& rng = pool.rng;
+    const float angle = rng.range(0.0f, 2.0f * float(M_PI));
+    const float radius = rng.range(0.9f, 1.5f);
+    const float ca = std::cos(angle), sa = std::sin(angle);
+
+    ParticleSpawn s;
+    s.x = radius * ca;
+    s.y = rng.range(-0.5f, 0.5f);
+    s.z = radius * sa;
+    s.vx = -sa * radius * 0.5f;   // orbit at the ring's 0.5 rad/s
+    s.vz = ca * radius * 0.5f;
+    s.life = rng.range(0.5f, 1.0f) * meditation.particleDuration;
+    s.size = 0.03f;
+    s.r = 0.9f; s.g = 0.95f; s.b = 1.0f; s.a = 0.8f;
+    return spawnParticle(pool, s);
 }
@@ -52,3 +52,8 @@ void triggerMeditation();
 void updateMeditationAnimation();
 void drawLotusPlatform(float x, float y, float z);
 void drawMeditationParticles(float x, float y, float z);
+
+// The orbiting motes as an emitter (same band, colour and fade cycle), used
+// by the particle stress mode. Centre frame; false when the pool is full.
+struct ParticlePool;
+bool spawnMeditationParticle(ParticlePool& pool);
@@ -0,0 +1,223 @@
+#include "meshInstancing.hpp"
+#include "glExtensions.hpp"
+#include "utils.hpp"
+#include <cmath>
+#include <cstdio>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+// ---------- transforms ----------
+InstanceXform xformIdentity() {
+    InstanceXform x = { { { 1, 0, 0, 0 }, { 0, 1, 0, 0 }, { 0, 0, 1, 0 } } };
+    return x;
+}
+
+// x = x * b  (b given as a 3x4 block, implicit last row 0 0 0 1)
+static void xformMul(InstanceXform& x, const float b[3][4]) {
+    InstanceXform r;
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            r.m[i][j] = x.m[i][0] * b[0][j] + x.m[i][1] * b[1][j] + x.m[i][2] * b[2][j];
+        }
+        r.m[i][3] += x.m[i][3];
+    }
+    x = r;
+}
+
+void xformTranslate(InstanceXform& x, float tx, float ty, float tz) {
+    for (int i = 0; i < 3; ++i)
+        x.m[i][3] += x.m[i][0] * tx + x.m[i][1] * ty + x.m[i][2] * tz;
+}
+
+void xformRotate(InstanceXform& x, float degrees, float ax, float ay, float az) {
+    const float a = degrees * (float)M_PI / 180.0f;
+    const float c = std::cos(a), s = std::sin(a), t = 1.0f - c;
+    const float b[3][4] = {
+        { t * ax * ax + c,      t * ax * ay - s * az, t * ax * az + s * ay, 0 },
+        { t * ax * ay + s * az, t * ay * ay + c,      t * ay * az - s * ax, 0 },
+        { t * ax * az - s * ay, t * ay * az + s * ax, t * az * az + c,      0 },
+    };
+    xformMul(x, b);
+}
+
+void xformScale(InstanceXform& x, float sx, float sy, float sz) {
+    for (int i = 0; i < 3; ++i) { x.m[i][0] *= sx; x.m[i][1] *= sy; x.m[i][2] *= sz; }
+}
+
+// ---------- instanced shader ----------
+// Attributes 3..6 carry the instance (rows of the transform + colour);
+// 0 is left alone since some drivers alias it with gl_Vertex.
+static const char* kInstanceVS = R"(#version 330 compatibility
+layout(location = 3) in vec4 iRow0;
+layout(location = 4) in vec4 iRow1;
+layout(location = 5) in vec4 iRow2;
+layout(location = 6) in vec4 iColor;
+out vec4 vColor;
+out vec2 vUV;
+void main() {
+    vec4 p = gl_Vertex;
+    gl_Position = gl_ModelViewProjectionMatrix * vec4(dot(iRow0, p), dot(iRow1, p), dot(iRow2, p), 1.0);
+    vColor = iColor;
+    vUV = gl_MultiTexCoord0.xy;
+}
+)";
+
+static const char* kInstanceFS = R"(#version 330 compatibility
+in vec4 vColor;
+in vec2 vUV;
+uniform sampler2D uTex;
+uniform int uTextured;
+out vec4 fragColor;
+void main() {
+    vec4 c = vColor;
+    if (uTextured != 0) c *= texture(uTex, vUV);
+    fragColor = c;
+}
+)";
+
+static const GLuint kInstanceAttrib = 3;      // first of four vec4 attributes
+static GLuint gInstanceProgram = 0;
+static GLint  gTexturedLoc = -1, gTexLoc = -1;
+static GLuint gInstanceVbo = 0;
+
+bool meshInstancingAvailable() {
+    static int state = -1;
+    if (state >= 0) return state == 1;
+
+    state = 0;
+    if (initGLExtensions() && glVersionAtLeast(3, 3) &&
+        gGL.vertexAttribDivisor && gGL.drawElementsInstanced) {
+        gInstanceProgram = buildGLProgram(kInstanceVS, kInstanceFS);
+        if (gInstanceProgram) {
+            gTexturedLoc = gGL.getUniformLocation(gInstanceProgram, "uTextured");
+            gTexLoc = gGL.getUniformLocation(gInstanceProgram, "uTex");
+            gGL.genBuffers(1, &gInstanceVbo);
+            state = 1;
+        }
+    }
+    std::printf("Mesh instancing: %s\n", state ? "glDrawElementsInstanced" : "display-list fallback");
+    return state == 1;
+}
+
+// ---------- mesh ----------
+void buildSphereMesh(InstancedMesh& mesh, int slices, int stacks) {
+    if (!mesh.vertices.empty()) return;
+    mesh.slices = slices;
+    mesh.stacks = stacks;
+
+    // same parameterisation as gluSphere: rho from +Z down, s around, t = 1 at the top
+    for (int i = 0; i <= stacks; ++i) {
+        const float rho = (float)M_PI * i / stacks;
+        for (int j = 0; j <= slices; ++j) {
+            const float theta = 2.0f * (float)M_PI * j / slices;
+            mesh.vertices.push_back(-std::sin(theta) * std::sin(rho));
+            mesh.vertices.push_back(std::cos(theta) * std::sin(rho));
+            mesh.vertices.push_back(std::cos(rho));
+            mesh.vertices.push_back((float)j / slices);
+            mesh.vertices.push_back(1.0f - (float)i / stacks);
+        }
+    }
+    const int row = slices + 1;
+    for (int i = 0; i < stacks; ++i) {
+        for (int j = 0; j < slices; ++j) {
+            const unsigned short a = (unsigned short)(i * row + j), b = (unsigned short)(a + row);
+            // counter-clockwise seen from outside
+            mesh.indices.push_back(a); mesh.indices.push_back(b); mesh.indices.push_back((unsigned short)(a + 1));
+            mesh.indices.push_back((unsigned short)(a + 1)); mesh.indices.push_back(b); mesh.indices.push_back((unsigned short)(b + 1));
+        }
+    }
+}
+
+static void bindMeshArrays(const InstancedMesh& mesh, bool useBuffers) {
+    const GLsizei stride = 5 * sizeof(float);
+    const char* base = useBuffers ? nullptr : (const char*)mesh.vertices.data();
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    glVertexPointer(3, GL_FLOAT, stride, base);
+    glTexCoordPointer(2, GL_FLOAT, stride, base + 3 * sizeof(float));
+}
+
+static void ensureMeshUploaded(InstancedMesh& mesh) {
+    if (mesh.vbo) return;
+    gGL.genBuffers(1, &mesh.vbo);
+    gGL.bindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
+    gGL.bufferData(GL_ARRAY_BUFFER, (ptrdiff_t)(mesh.vertices.size() * sizeof(float)), mesh.vertices.data(), GL_STATIC_DRAW);
+    gGL.genBuffers(1, &mesh.ibo);
+    gGL.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.ibo);
+    gGL.bufferData(GL_ELEMENT_ARRAY_BUFFER, (ptrdiff_t)(mesh.indices.size() * sizeof(unsigned short)), mesh.indices.data(), GL_STATIC_DRAW);
+    gGL.bindBuffer(GL_ARRAY_BUFFER, 0);
+    gGL.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+}
+
+static void ensureMeshList(InstancedMesh& mesh) {
+    if (mesh.list) return;
+    mesh.list = glGenLists(1);
+    glNewList(mesh.list, GL_COMPILE);
+    glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+    bindMeshArrays(mesh, false);
+    glDrawElements(GL_TRIANGLES, (GLsizei)mesh.indices.size(), GL_UNSIGNED_SHORT, mesh.indices.data());
+    glPopClientAttrib();
+    glEndList();
+}
+
+static void drawInstancedPath(InstancedMesh& mesh, const MeshInstance* instances, int count, bool textured) {
+    ensureMeshUploaded(mesh);
+
+    gGL.useProgram(gInstanceProgram);
+    gGL.uniform1i(gTexturedLoc, textured ? 1 : 0);
+    gGL.uniform1i(gTexLoc, 0);
+
+    glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+    gGL.bindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
+    bindMeshArrays(mesh, true);
+
+    // per-frame instance buffer: orphaned and refilled each draw
+    const GLsizei stride = sizeof(MeshInstance);
+    gGL.bindBuffer(GL_ARRAY_BUFFER, gInstanceVbo);
+    gGL.bufferData(GL_ARRAY_BUFFER, (ptrdiff_t)count * stride, instances, GL_STREAM_DRAW);
+    for (GLuint k = 0; k < 4; ++k) {
+        gGL.enableVertexAttribArray(kInstanceAttrib + k);
+        gGL.vertexAttribPointer(kInstanceAttrib + k, 4, GL_FLOAT, GL_FALSE, stride, (const void*)(k * 4 * sizeof(float)));
+        gGL.vertexAttribDivisor(kInstanceAttrib + k, 1);
+    }
+
+    gGL.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.ibo);
+    gGL.drawElementsInstanced(GL_TRIANGLES, (GLsizei)mesh.indices.size(), GL_UNSIGNED_SHORT, nullptr, count);
+
+    for (GLuint k = 0; k < 4; ++k) {
+        gGL.vertexAttribDivisor(kInstanceAttrib + k, 0);
+        gGL.disableVertexAttribArray(kInstanceAttrib + k);
+    }
+    gGL.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    gGL.bindBuffer(GL_ARRAY_BUFFER, 0);
+    glPopClientAttrib();
+    gGL.useProgram(0);
+}
+
+static void drawFallbackPath(InstancedMesh& mesh, const MeshInstance* instances, int count) {
+    ensureMeshList(mesh);
+    for (int i = 0; i < count; ++i) {
+        const float (*m)[4] = instances[i].xform.m;
+        const GLfloat cols[16] = {   // column-major for glMultMatrixf
+            m[0][0], m[1][0], m[2][0], 0,
+            m[0][1], m[1][1], m[2][1], 0,
+            m[0][2], m[1][2], m[2][2], 0,
+            m[0][3], m[1][3], m[2][3], 1
+        };
+        glPushMatrix();
+        glMultMatrixf(cols);
+        glColor4fv(instances[i].rgba);
+        glCallList(mesh.list);
+        glPopMatrix();
+    }
+}
+
+void drawMeshInstances(InstancedMesh& mesh, const MeshInstance* instances, int count, bool textured) {
+    if (count <= 0 || mesh.indices.empty()) return;
+    // the fallback's texturing follows GL_TEXTURE_2D as set by the caller
+    if (meshInstancingAvailable()) drawInstancedPath(mesh, instances, count, textured);
+    else drawFallbackPath(mesh, instances, count);
+    countGLTriangles((int)(mesh.indices.size() / 3) * count);
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <GL/freeglut.h>
+#include <vector>
+
+// ---------------- Instanced meshes ----------------
+// A mesh is built once (unit sphere: positions + UVs, indexed) and drawn
+// many times from a small per-frame instance array: one affine transform
+// and one RGBA colour per copy. On GL 3.3+ the whole array is a single
+// glDrawElementsInstanced; otherwise each instance is a glMultMatrix plus a
+// glCallList of the cached mesh, which still skips the per-call tessellation
+// that glutSolidSphere/gluSphere do.
+
+// Row-major 3x4 affine transform. The helpers post-multiply like the GL
+// matrix stack, so glTranslate/glRotate/glScale sequences port line by line.
+struct InstanceXform {
+    float m[3][4];
+};
+
+InstanceXform xformIdentity();
+void xformTranslate(InstanceXform& x, float tx, float ty, float tz);
+void xformRotate(InstanceXform& x, float degrees, float ax, float ay, float az); // unit axis
+void xformScale(InstanceXform& x, float sx, float sy, float sz);
+
+struct MeshInstance {
+    InstanceXform xform;
+    float rgba[4];      // colour; glow is folded into alpha by the caller
+};
+
+struct InstancedMesh {
+    int slices = 0, stacks = 0;
+    std::vector<float> vertices;          // x, y, z, u, v
+    std::vector<unsigned short> indices;  // triangles
+    GLuint vbo = 0, ibo = 0;              // buffer objects (shader path)
+    GLuint list = 0;                      // display list (fallback path)
+};
+
+// Unit sphere around the Z axis with gluSphere's texture layout (lazy: the
+// first call for a mesh builds it, later calls are free).
+void buildSphereMesh(InstancedMesh& mesh, int slices, int stacks);
+
+// Draw every instance in the current modelview frame. `textured` samples the
+// texture bound to unit 0 (modulated by the instance colour).
+void drawMeshInstances(InstancedMesh& mesh, const MeshInstance* instances, int count, bool textured);
+
+bool meshInstancingAvailable();   // GL 3.3 instanced path in use
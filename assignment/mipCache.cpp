@@ -0,0 +1,138 @@
+#include "mipCache.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+static const char kMagic[4] = { 'N', 'Z', 'M', 'P' };
+static const uint32_t kVersion = 1;
+
+// file layout: header, level table, source path, padding, texels
+struct MipCacheHeader {
+    char     magic[4];
+    uint32_t version;
+    uint64_t sourceSize;
+    int64_t  sourceTime;
+    int32_t  maxSize;        // GL_MAX_TEXTURE_SIZE the chain was built for
+    uint32_t levelCount;
+    uint32_t pathLength;
+    uint32_t reserved;
+    uint64_t texelOffset;    // from the start of the file, 16-byte aligned
+    uint64_t texelBytes;
+};
+
+struct MipCacheLevel {
+    int32_t  width, height;
+    uint64_t offset;         // into the texel block
+};
+
+static std::string cachePath(const char* source) { return std::string(source) + ".mips"; }
+
+static bool sourceStamp(const char* path, uint64_t& size, int64_t& time) {
+#if defined(_WIN32)
+    struct _stat64 st;
+    if (_stat64(path, &st) != 0) return false;
+#else
+    struct stat st;
+    if (stat(path, &st) != 0) return false;
+#endif
+    size = (uint64_t)st.st_size;
+    time = (int64_t)st.st_mtime;
+    return true;
+}
+
+bool openCachedMipChain(const char* source, int maxSize, CachedMipChain& out) {
+    uint64_t size = 0;
+    int64_t time = 0;
+    if (!sourceStamp(source, size, time)) return false;
+
+    MappedFile& f = out.file;
+    if (!openMappedFile(f, cachePath(source).c_str())) return false;
+
+    const size_t pathLength = std::strlen(source);
+    MipCacheHeader h;
+    bool ok = f.size >= sizeof(h);
+    if (ok) {
+        std::memcpy(&h, f.data, sizeof(h));
+        const uint64_t tableEnd = sizeof(h) + (uint64_t)h.levelCount * sizeof(MipCacheLevel) + h.pathLength;
+        ok = std::memcmp(h.magic, kMagic, 4) == 0 && h.version == kVersion &&
+            h.sourceSize == size && h.sourceTime == time && h.maxSize == maxSize &&
+            h.levelCount > 0 && h.levelCount <= 32 && h.pathLength == pathLength &&
+            tableEnd <= h.texelOffset && h.texelOffset <= f.size &&
+            h.texelBytes <= f.size - h.texelOffset;   // no sums that could wrap
+    }
+    if (ok) {
+        const unsigned char* table = f.data + sizeof(h);
+        ok = std::memcmp(table + h.levelCount * sizeof(MipCacheLevel), source, pathLength) == 0;
+
+        out.levels.clear();
+        for (uint32_t i = 0; ok && i < h.levelCount; ++i) {
+            MipCacheLevel l;
+            std::memcpy(&l, table + i * sizeof(l), sizeof(l));
+            ok = l.width > 0 && l.height > 0 && l.width <= maxSize && l.height <= maxSize &&
+                l.offset <= h.texelBytes &&
+                (uint64_t)l.width * l.height * 4 <= h.texelBytes - l.offset;
+            out.levels.push_back(MipLevel{ l.width, l.height, (size_t)l.offset });
+        }
+    }
+    if (!ok) {
+        closeCachedMipChain(out);
+        return false;
+    }
+    out.texels = f.data + h.texelOffset;
+    out.bytes = (size_t)h.texelBytes;
+    return true;
+}
+
+void closeCachedMipChain(CachedMipChain& c) {
+    closeMappedFile(c.file);
+    c.levels.clear();
+    c.texels = nullptr;
+    c.bytes = 0;
+}
+
+bool writeCachedMipChain(const char* source, int maxSize, const MipChain& chain) {
+    MipCacheHeader h;
+    std::memset(&h, 0, sizeof(h));
+    if (!sourceStamp(source, h.sourceSize, h.sourceTime) || chain.levels.empty()) return false;
+
+    const size_t pathLength = std::strlen(source);
+    std::memcpy(h.magic, kMagic, 4);
+    h.version = kVersion;
+    h.maxSize = maxSize;
+    h.levelCount = (uint32_t)chain.levels.size();
+    h.pathLength = (uint32_t)pathLength;
+    const uint64_t tableEnd = sizeof(h) + (uint64_t)h.levelCount * sizeof(MipCacheLevel) + pathLength;
+    h.texelOffset = (tableEnd + 15) & ~(uint64_t)15;
+    h.texelBytes = chain.texels.size();
+
+    // write to a side file and swap it in, so a reader never maps half a cache
+    const std::string path = cachePath(source), temp = path + ".tmp";
+    FILE* f = std::fopen(temp.c_str(), "wb");
+    if (!f) return false;
+
+    static const unsigned char kZeros[16] = {};
+    bool ok = std::fwrite(&h, sizeof(h), 1, f) == 1;
+    for (size_t i = 0; ok && i < chain.levels.size(); ++i) {
+        const MipLevel& l = chain.levels[i];
+        const MipCacheLevel cl = { l.width, l.height, (uint64_t)l.offset };
+        ok = std::fwrite(&cl, sizeof(cl), 1, f) == 1;
+    }
+    ok = ok && std::fwrite(source, 1, pathLength, f) == pathLength;
+    ok = ok && std::fwrite(kZeros, 1, (size_t)(h.texelOffset - tableEnd), f) == h.texelOffset - tableEnd;
+    ok = ok && std::fwrite(chain.texels.data(), 1, chain.texels.size(), f) == chain.texels.size();
+    ok = std::fclose(f) == 0 && ok;
+
+    if (ok) {
+        std::remove(path.c_str());   // rename won't replace on Windows
+        ok = std::rename(temp.c_str(), path.c_str()) == 0;
+    }
+    if (!ok) std::remove(temp.c_str());
+    return ok;
+}
+
+void uploadCachedMipChain(const CachedMipChain& c) {
+    uploadMipLevels(c.levels.data(), (int)c.levels.size(), c.texels);
+}
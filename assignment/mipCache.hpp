@@ -0,0 +1,29 @@
+#pragma once
+#include <vector>
+#include "mipChain.hpp"
+#include "mappedFile.hpp"
+
+// ---------------- On-disk mip-chain cache ----------------
+// A built mip chain is saved next to its source image ("<path>.mips") with
+// the source's size and modification time and the GL size limit it was
+// built for. Later starts map the cache and upload the levels straight out
+// of the mapping, skipping both the decode and the filtering; a cache whose
+// key no longer matches is ignored and rewritten after the next build.
+// Levels are stored as plain BGRA8, exactly what uploadMipChain sends.
+
+struct CachedMipChain {
+    MappedFile file;
+    std::vector<MipLevel> levels;      // offsets into `texels`
+    const unsigned char* texels = nullptr;
+    size_t bytes = 0;
+};
+
+// False when there is no cache for `source` or it is stale. Any thread.
+bool openCachedMipChain(const char* source, int maxSize, CachedMipChain& out);
+void closeCachedMipChain(CachedMipChain& c);
+
+// Write (or replace) the cache for `source`. Any thread; false on I/O errors.
+bool writeCachedMipChain(const char* source, int maxSize, const MipChain& chain);
+
+// glTexImage2D every level into the bound GL_TEXTURE_2D (trilinear min filter)
+void uploadCachedMipChain(const CachedMipChain& c);
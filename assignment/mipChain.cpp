@@ -0,0 +1,105 @@
+#include "mipChain.hpp"
+#include <cstring>
+
+#ifndef GL_BGRA_EXT
+#define GL_BGRA_EXT 0x80E1
+#endif
+
+int mipNearestPower(int value) {
+    // GLU: shift down, and round up when the two top bits are both set
+    int p = 1;
+    if (value <= 0) return 1;
+    for (;;) {
+        if (value == 1) return p;
+        if (value == 3) return p * 4;
+        value >>= 1;
+        p *= 2;
+    }
+}
+
+void resampleBgra(const unsigned char* src, int sw, int sh, unsigned char* dst, int dw, int dh) {
+    const float sx = (float)sw / dw, sy = (float)sh / dh;
+    for (int y = 0; y < dh; ++y) {
+        float fy = (y + 0.5f) * sy - 0.5f;
+        if (fy < 0.0f) fy = 0.0f;
+        int y0 = (int)fy;
+        if (y0 > sh - 1) y0 = sh - 1;
+        const int y1 = y0 + 1 < sh ? y0 + 1 : y0;
+        const float ty = fy - y0;
+        for (int x = 0; x < dw; ++x) {
+            float fx = (x + 0.5f) * sx - 0.5f;
+            if (fx < 0.0f) fx = 0.0f;
+            int x0 = (int)fx;
+            if (x0 > sw - 1) x0 = sw - 1;
+            const int x1 = x0 + 1 < sw ? x0 + 1 : x0;
+            const float tx = fx - x0;
+            const unsigned char* a = src + ((size_t)y0 * sw + x0) * 4;
+            const unsigned char* b = src + ((size_t)y0 * sw + x1) * 4;
+            const unsigned char* c = src + ((size_t)y1 * sw + x0) * 4;
+            const unsigned char* d = src + ((size_t)y1 * sw + x1) * 4;
+            unsigned char* o = dst + ((size_t)y * dw + x) * 4;
+            for (int k = 0; k < 4; ++k) {
+                const float top = a[k] + (b[k] - a[k]) * tx;
+                const float bot = c[k] + (d[k] - c[k]) * tx;
+                o[k] = (unsigned char)(top + (bot - top) * ty + 0.5f);
+            }
+        }
+    }
+}
+
+// 2x2 box filter; a side already at 1 is averaged along the other only
+static void halve(const unsigned char* src, int sw, int sh, unsigned char* dst, int dw, int dh) {
+    const int stepX = sw > 1 ? 1 : 0, stepY = sh > 1 ? 1 : 0;
+    for (int y = 0; y < dh; ++y) {
+        const unsigned char* r0 = src + (size_t)(y * 2) * sw * 4;
+        const unsigned char* r1 = r0 + (size_t)stepY * sw * 4;
+        unsigned char* o = dst + (size_t)y * dw * 4;
+        for (int x = 0; x < dw; ++x) {
+            const int i0 = x * 2 * 4, i1 = i0 + stepX * 4;
+            for (int k = 0; k < 4; ++k)
+                o[x * 4 + k] = (unsigned char)((r0[i0 + k] + r0[i1 + k] + r1[i0 + k] + r1[i1 + k] + 2) >> 2);
+        }
+    }
+}
+
+void buildMipChain(const unsigned char* bgra, int width, int height, int maxSize, MipChain& out) {
+    int w = mipNearestPower(width), h = mipNearestPower(height);
+    while (w > maxSize || h > maxSize) {   // GLU halves both until the proxy fits
+        if (w > 1) w >>= 1;
+        if (h > 1) h >>= 1;
+    }
+
+    // size the whole chain up front
+    out.levels.clear();
+    size_t total = 0;
+    for (int lw = w, lh = h;; lw = lw > 1 ? lw >> 1 : 1, lh = lh > 1 ? lh >> 1 : 1) {
+        out.levels.push_back(MipLevel{ lw, lh, total });
+        total += (size_t)lw * lh * 4;
+        if (lw == 1 && lh == 1) break;
+    }
+    out.texels.resize(total);
+
+    unsigned char* base = out.texels.data();
+    if (w == width && h == height) std::memcpy(base, bgra, (size_t)w * h * 4);
+    else resampleBgra(bgra, width, height, base, w, h);
+
+    for (size_t i = 1; i < out.levels.size(); ++i) {
+        const MipLevel& s = out.levels[i - 1];
+        const MipLevel& d = out.levels[i];
+        halve(base + s.offset, s.width, s.height, base + d.offset, d.width, d.height);
+    }
+}
+
+void uploadMipLevels(const MipLevel* levels, int count, const unsigned char* texels) {
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    for (int i = 0; i < count; ++i) {
+        const MipLevel& l = levels[i];
+        glTexImage2D(GL_TEXTURE_2D, i, GL_RGBA8, l.width, l.height, 0,
+            GL_BGRA_EXT, GL_UNSIGNED_BYTE, texels + l.offset);
+    }
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+}
+
+void uploadMipChain(const MipChain& chain) {
+    uploadMipLevels(chain.levels.data(), (int)chain.levels.size(), chain.texels.data());
+}
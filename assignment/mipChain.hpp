@@ -0,0 +1,32 @@
+#pragma once
+#include <GL/freeglut.h>
+#include <cstddef>
+#include <vector>
+
+// ---------------- CPU mip chains ----------------
+// What gluBuild2DMipmaps does, minus the GL calls, so it can run on a
+// worker thread: the image is resampled to the power-of-two size GLU would
+// pick (capped at maxSize) and halved with a 2x2 box filter down to 1x1.
+// Texels are BGRA8, top row first, every level packed back to back.
+
+struct MipLevel {
+    int width, height;
+    size_t offset;        // into MipChain::texels
+};
+
+struct MipChain {
+    std::vector<MipLevel> levels;
+    std::vector<unsigned char> texels;
+};
+
+// Power of two nearest to `value`, rounded the way GLU rounds it
+int mipNearestPower(int value);
+
+// Bilinear resample (texel centres aligned) into a dw x dh target
+void resampleBgra(const unsigned char* src, int sw, int sh, unsigned char* dst, int dw, int dh);
+
+void buildMipChain(const unsigned char* bgra, int width, int height, int maxSize, MipChain& out);
+
+// glTexImage2D every level into the bound GL_TEXTURE_2D (trilinear min filter)
+void uploadMipChain(const MipChain& chain);
+void uploadMipLevels(const MipLevel* levels, int count, const unsigned char* texels);
@@ -1,6 +1,16 @@
 #include "nezha_bg.hpp"
+#include "particleRng.hpp"
+#include "glExtensions.hpp"
+#include "batch2D.hpp"
 #include <cmath>
 #include <cstdlib>
+#include <cstdio>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  include <emmintrin.h>
+#  define EMBERS_SSE 1
+#endif
 
 NezhaBGState gNezhaBG;
 
@@ -14,6 +24,33 @@ static float frand() {
     return (gSeed / 2147483647.0f);
 }
 
+// Ember field: generated once (own RNG, so clouds are unaffected), then
+// animated purely from gNezhaBG.time. SoA so the animate loop runs 4-wide.
+struct EmberField {
+    std::vector<float> baseX, baseY, phase, speed;   // per ember, fixed
+    std::vector<float> xy, rgba;                     // per frame, drawn as one batch
+    ParticleRng rng;
+    int count = 0;
+};
+static EmberField gEmbers;
+
+static void growEmberField(int count) {
+    EmberField& e = gEmbers;
+    if (count <= (int)e.baseX.size()) { e.count = count; return; }
+
+    const size_t old = e.baseX.size();
+    const size_t cap = ((size_t)count + 3) & ~(size_t)3; // pad to the SIMD width
+    e.baseX.resize(cap); e.baseY.resize(cap); e.phase.resize(cap); e.speed.resize(cap);
+    e.xy.resize(cap * 2); e.rgba.resize(cap * 4);
+    for (size_t i = old; i < cap; ++i) {
+        e.baseX[i] = e.rng.next01();
+        e.baseY[i] = e.rng.next01() * 0.5f + 0.05f;
+        e.phase[i] = e.rng.range(0.0f, 6.2831853f);
+        e.speed[i] = e.rng.range(0.4f, 0.8f);
+    }
+    e.count = count;
+}
+
 void initNezhaBackground(int seed) {
     gSeed = seed;
     for (int i = 0; i < kCloudCount; ++i) {
@@ -23,6 +60,38 @@ void initNezhaBackground(int seed) {
         gClouds[i].speed = 0.005f + frand() * 0.02f;
         gClouds[i].phase = frand() * 100.0f;
     }
+
+    gEmbers = EmberField();
+    gEmbers.rng.seed((uint32_t)seed ^ 0xE3BE125u);
+    growEmberField(gNezhaBG.emberCount);
+}
+
+void setNezhaEmberCount(int count) {
+    if (count < 0) count = 0;
+    gNezhaBG.emberCount = count;
+    growEmberField(count);
+    std::printf("Background embers: %d\n", count);
+}
+
+void cycleNezhaEmberCount() {
+    int next = gNezhaBG.emberCount * 4;
+    if (next > 16384) next = 60;
+    setNezhaEmberCount(next);
+}
+
+void setNezhaSlowLayerHz(float hz) {
+    if (hz < 0.0f) hz = 0.0f;
+    gNezhaBG.slowLayerHz = hz;
+    if (hz > 0.0f) std::printf("Background clouds/halo: cached, refreshed at %g Hz\n", hz);
+    else std::printf("Background clouds/halo: drawn every frame\n");
+}
+
+void cycleNezhaSlowLayerHz() {
+    static const float kRates[] = { 0.0f, 30.0f, 15.0f, 5.0f };
+    const int n = (int)(sizeof(kRates) / sizeof(kRates[0]));
+    int i = 0;
+    while (i < n && kRates[i] != gNezhaBG.slowLayerHz) ++i;
+    setNezhaSlowLayerHz(kRates[(i + 1) % n]);   // an off-list rate restarts at "every frame"
 }
 
 // ------------- 2D helpers -------------
@@ -51,28 +120,30 @@ static void end2D() {
     glMatrixMode(GL_MODELVIEW); // leave MODELVIEW active (important)
 }
 
-static void quadGradientVert(float x, float y, float r, float g, float b, float a) {
-    glColor4f(r, g, b, a);
-    glVertex2f(x, y);
+// Unit circle shared by every disc (the cloud layer alone is 60 discs)
+static const int kDiscSeg = 48;
+static float gCircle[kDiscSeg + 1][2];
+static void buildCircleTable() {
+    if (gCircle[1][0] != 0.0f || gCircle[1][1] != 0.0f) return;
+    for (int i = 0; i <= kDiscSeg; ++i) {
+        float t = (float)i / (float)kDiscSeg * 6.2831853f;
+        gCircle[i][0] = std::cos(t);
+        gCircle[i][1] = std::sin(t);
+    }
 }
 
 static void drawDisc(float cx, float cy, float r, float aCenter, float aEdge) {
-    const int seg = 48;
-    glBegin(GL_TRIANGLE_FAN);
-    glColor4f(1.0f, 1.0f, 1.0f, aCenter);
-    glVertex2f(cx, cy);
-    glColor4f(1.0f, 1.0f, 1.0f, aEdge);
-    for (int i = 0; i <= seg; ++i) {
-        float t = (float)i / (float)seg * 6.2831853f;
-        glVertex2f(cx + std::cos(t) * r, cy + std::sin(t) * r);
-    }
-    glEnd();
+    Batch2DVertex v[kDiscSeg + 2];
+    v[0] = { cx, cy, 1.0f, 1.0f, 1.0f, aCenter };
+    for (int i = 0; i <= kDiscSeg; ++i)
+        v[i + 1] = { cx + gCircle[i][0] * r, cy + gCircle[i][1] * r, 1.0f, 1.0f, 1.0f, aEdge };
+    batch2DFan(BLEND_ALPHA, v, kDiscSeg + 2);
 }
 
 static void drawRibbonArc(float cx, float cy, float r0, float r1, float a0, float a1,
     float amp, float freq, float alpha, float rr, float gg, float bb) {
     const int seg = 96;
-    glBegin(GL_TRIANGLE_STRIP);
+    Batch2DVertex v[(seg + 1) * 2];
     for (int i = 0; i <= seg; ++i) {
         float u = (float)i / (float)seg;
         float a = a0 + (a1 - a0) * u;
@@ -80,31 +151,19 @@ static void drawRibbonArc(float cx, float cy, float r0, float r1, float a0, floa
         float rInner = r0 + wobble;
         float rOuter = r1 + wobble;
         float cs = std::cos(a), sn = std::sin(a);
-        glColor4f(rr, gg, bb, alpha * (0.6f + 0.4f * (1.0f - u)));
-        glVertex2f(cx + cs * rOuter, cy + sn * rOuter);
-        glColor4f(rr, gg, bb, alpha * (0.4f + 0.6f * u));
-        glVertex2f(cx + cs * rInner, cy + sn * rInner);
+        v[i * 2 + 0] = { cx + cs * rOuter, cy + sn * rOuter, rr, gg, bb, alpha * (0.6f + 0.4f * (1.0f - u)) };
+        v[i * 2 + 1] = { cx + cs * rInner, cy + sn * rInner, rr, gg, bb, alpha * (0.4f + 0.6f * u) };
     }
-    glEnd();
+    batch2DStrip(BLEND_ALPHA, v, (seg + 1) * 2);
 }
 
 // ------------- elements -------------
 static void drawSkyGradient() {
-    float topR = 0.08f, topG = 0.07f, topB = 0.16f;
-    float midR = 0.35f, midG = 0.10f, midB = 0.32f;
-    float botR = 0.95f, botG = 0.42f, botB = 0.12f;
-
-    glBegin(GL_QUADS);
-    quadGradientVert(0, 1, topR, topG, topB, 1.0f);
-    quadGradientVert(1, 1, topR, topG, topB, 1.0f);
-    quadGradientVert(1, 0.55f, midR, midG, midB, 1.0f);
-    quadGradientVert(0, 0.55f, midR, midG, midB, 1.0f);
-
-    quadGradientVert(0, 0.55f, midR, midG, midB, 1.0f);
-    quadGradientVert(1, 0.55f, midR, midG, midB, 1.0f);
-    quadGradientVert(1, 0, botR, botG, botB, 1.0f);
-    quadGradientVert(0, 0, botR, botG, botB, 1.0f);
-    glEnd();
+    const float top[4] = { 0.08f, 0.07f, 0.16f, 1.0f };
+    const float mid[4] = { 0.35f, 0.10f, 0.32f, 1.0f };
+    const float bot[4] = { 0.95f, 0.42f, 0.12f, 1.0f };
+    batch2DQuad(BLEND_ALPHA, 0, 0.55f, 1, 1, mid, top);
+    batch2DQuad(BLEND_ALPHA, 0, 0, 1, 0.55f, bot, mid);
 }
 static void drawSunGlow() {
     float cx = 0.72f, cy = 0.78f;
@@ -124,84 +183,477 @@ static void drawClouds() {
         drawDisc(x + s * 0.25f, y + s * 0.30f, s * 0.6f, 0.12f, 0.0f);
     }
 }
-static void drawLotusHaloAndRibbons() {
-    const float cx = 0.5f, cy = 0.58f;
-    const int petals = 18;
+static const float kHaloX = 0.5f, kHaloY = 0.58f;
+
+static void drawLotusHalo() {
+    const float cx = kHaloX, cy = kHaloY;
+    const int petals = 18, seg = 18;
+    Batch2DVertex v[seg + 2];
     for (int i = 0; i < petals; ++i) {
         float a = (6.2831853f * i) / petals;
         float r = 0.10f + 0.02f * std::sin(gNezhaBG.time * 0.8f + i);
-        glPushMatrix();
-        glTranslatef(cx, cy, 0);
-        glRotatef(a * 57.29578f, 0, 0, 1);
-        glBegin(GL_TRIANGLE_FAN);
-        glColor4f(1.0f, 0.9f, 0.6f, 0.14f);
-        glVertex2f(0, 0);
-        glColor4f(1.0f, 0.8f, 0.3f, 0.0f);
-        for (int k = 0; k <= 18; ++k) {
-            float t = (float)k / 18.0f * 3.14159f;
+        float ca = std::cos(a), sa = std::sin(a);
+        v[0] = { cx, cy, 1.0f, 0.9f, 0.6f, 0.14f };
+        for (int k = 0; k <= seg; ++k) {
+            float t = (float)k / (float)seg * 3.14159f;
             float ex = std::cos(t) * r;
             float ey = std::sin(t) * r * 0.55f;
-            glVertex2f(ex, ey);
+            v[k + 1] = { cx + ca * ex - sa * ey, cy + sa * ex + ca * ey, 1.0f, 0.8f, 0.3f, 0.0f };
         }
-        glEnd();
-        glPopMatrix();
+        batch2DFan(BLEND_ALPHA, v, seg + 2);
     }
+}
+// The ribbon wobble is a function of angle only, so the ribbons are static,
+// but they cross the clouds and must stay drawn after them: they are cached
+// only together with the clouds and halo.
+static void drawRibbons() {
+    const float cx = kHaloX, cy = kHaloY;
     float a0 = 190.0f * 3.14159f / 180.0f;
     float a1 = 350.0f * 3.14159f / 180.0f;
     drawRibbonArc(cx, cy, 0.22f, 0.27f, a0, a1, 0.01f, 6.0f, 0.55f, 0.95f, 0.15f, 0.10f);
     drawRibbonArc(cx, cy, 0.28f, 0.33f, a0 + 0.12f, a1 + 0.12f, 0.012f, 7.5f, 0.35f, 0.95f, 0.15f, 0.10f);
 }
+
+// ------------- static layer cache -------------
+// Rendered into a texture through an FBO (GL 3.0); without one, the layers
+// are drawn straight into the freshly cleared back buffer and copied out
+// with glCopyTexSubImage2D, which costs nothing extra on the bake frame.
+struct BackgroundCache {
+    GLuint tex = 0, fbo = 0;
+    int w = 0, h = 0;            // window size (0 until the first reshape)
+    int texW = 0, texH = 0;      // allocated size (power of two without NPOT)
+    bool dirty = true;
+    bool slowBaked = false;      // clouds, halo and ribbons are in the texture
+    float bakedAt = 0.0f;        // gNezhaBG.time of the last bake
+};
+static BackgroundCache gBGCache;
+
+static int nextPow2(int v) { int p = 1; while (p < v) p <<= 1; return p; }
+
+static bool allocBackgroundCache() {
+    BackgroundCache& c = gBGCache;
+    const bool npot = initGLExtensions() && glVersionAtLeast(2, 0);
+    const int tw = npot ? c.w : nextPow2(c.w), th = npot ? c.h : nextPow2(c.h);
+    if (c.tex && tw == c.texW && th == c.texH) return true;
+
+    GLint maxSize = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxSize);
+    if (tw > maxSize || th > maxSize) return false;
+
+    if (!c.tex) glGenTextures(1, &c.tex);
+    glBindTexture(GL_TEXTURE_2D, c.tex);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, tw, th, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    c.texW = tw; c.texH = th;
+
+    if (gGL.genFramebuffers && !c.fbo) {
+        gGL.genFramebuffers(1, &c.fbo);
+        gGL.bindFramebuffer(GL_FRAMEBUFFER, c.fbo);
+        gGL.framebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, c.tex, 0);
+        const bool complete = gGL.checkFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+        gGL.bindFramebuffer(GL_FRAMEBUFFER, 0);
+        if (!complete) {
+            gGL.deleteFramebuffers(1, &c.fbo);
+            c.fbo = 0;
+            std::printf("Background cache: FBO incomplete, using back-buffer copies\n");
+        }
+    }
+    return true;
+}
+
+static void drawCachedLayers(bool withSlow) {
+    drawSkyGradient();
+    drawSunGlow();
+    if (withSlow) { drawClouds(); drawLotusHalo(); drawRibbons(); }
+    batch2DFlush();
+}
+
+static void compositeBackgroundCache() {
+    const BackgroundCache& c = gBGCache;
+    const float u1 = (float)c.w / c.texW, v1 = (float)c.h / c.texH;
+
+    glPushAttrib(GL_ENABLE_BIT | GL_TEXTURE_BIT);
+    glDisable(GL_BLEND);
+    glEnable(GL_TEXTURE_2D);
+    glBindTexture(GL_TEXTURE_2D, c.tex);
+    glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_REPLACE);
+    glBegin(GL_QUADS);
+    glTexCoord2f(0, 0);   glVertex2f(0, 0);
+    glTexCoord2f(u1, 0);  glVertex2f(1, 0);
+    glTexCoord2f(u1, v1); glVertex2f(1, 1);
+    glTexCoord2f(0, v1);  glVertex2f(0, 1);
+    glEnd();
+    glPopAttrib();
+}
+
+// Draws the cached layers (baking first when stale). False when the cache
+// can't be used and the caller should draw everything directly.
+static bool drawBackgroundCache(bool withSlow) {
+    BackgroundCache& c = gBGCache;
+    if (c.w <= 0 || c.h <= 0) return false;
+    if (c.dirty && !allocBackgroundCache()) return false;
+
+    bool stale = c.dirty || withSlow != c.slowBaked;
+    if (!stale && withSlow) {
+        const float age = gNezhaBG.time - c.bakedAt;
+        stale = age < 0.0f || age >= 1.0f / gNezhaBG.slowLayerHz;
+    }
+    if (!stale) { compositeBackgroundCache(); return true; }
+
+    if (c.fbo) {
+        glPushAttrib(GL_VIEWPORT_BIT);
+        gGL.bindFramebuffer(GL_FRAMEBUFFER, c.fbo);
+        glViewport(0, 0, c.w, c.h);
+        drawCachedLayers(withSlow);
+        gGL.bindFramebuffer(GL_FRAMEBUFFER, 0);
+        glPopAttrib();
+        compositeBackgroundCache();
+    }
+    else {
+        // the layers land in the back buffer as this frame's background anyway
+        drawCachedLayers(withSlow);
+        glBindTexture(GL_TEXTURE_2D, c.tex);
+        glCopyTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 0, 0, c.w, c.h);
+    }
+    c.dirty = false;
+    c.slowBaked = withSlow;
+    c.bakedAt = gNezhaBG.time;
+    return true;
+}
+
+#if defined(EMBERS_SSE)
+// sin for |x| <= pi: parabola fit plus one refinement (error ~0.001)
+static inline __m128 sinPi4(__m128 x) {
+    const __m128 B = _mm_set1_ps(4.0f / 3.14159265f);
+    const __m128 C = _mm_set1_ps(-4.0f / (3.14159265f * 3.14159265f));
+    const __m128 P = _mm_set1_ps(0.225f);
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    __m128 y = _mm_add_ps(_mm_mul_ps(B, x), _mm_mul_ps(_mm_mul_ps(C, x), _mm_and_ps(x, absMask)));
+    return _mm_add_ps(_mm_mul_ps(P, _mm_sub_ps(_mm_mul_ps(y, _mm_and_ps(y, absMask)), y)), y);
+}
+// wrap any angle to [-pi, pi) and take its sin
+static inline __m128 sin4(__m128 x) {
+    const __m128 inv2Pi = _mm_set1_ps(1.0f / 6.2831853f), twoPi = _mm_set1_ps(6.2831853f);
+    __m128 k = _mm_mul_ps(x, inv2Pi);
+    k = _mm_cvtepi32_ps(_mm_cvtps_epi32(k));          // round to nearest turn
+    return sinPi4(_mm_sub_ps(x, _mm_mul_ps(k, twoPi)));
+}
+#endif
+
+// x = fract(baseX + 0.02 sin(t)), y = baseY + 0.05 sin(0.7 t), a = 0.65 (0.5 + 0.5 sin(t))
+// with t = time * 0.6 * speed + phase
+static void animateEmbers(float time) {
+    EmberField& e = gEmbers;
+    const int n = e.count;
+    int i = 0;
+#if defined(EMBERS_SSE)
+    const __m128 tt = _mm_set1_ps(time * 0.6f);
+    const __m128 half = _mm_set1_ps(0.5f), seven = _mm_set1_ps(0.7f);
+    const __m128 ax = _mm_set1_ps(0.02f), ay = _mm_set1_ps(0.05f), aa = _mm_set1_ps(0.65f);
+    const __m128 one = _mm_set1_ps(1.0f), r = _mm_set1_ps(1.0f), g = _mm_set1_ps(0.6f), b = _mm_set1_ps(0.2f);
+    for (; i + 4 <= n; i += 4) {
+        __m128 t = _mm_add_ps(_mm_mul_ps(tt, _mm_loadu_ps(&e.speed[i])), _mm_loadu_ps(&e.phase[i]));
+        __m128 s = sin4(t);
+        __m128 x = _mm_add_ps(_mm_loadu_ps(&e.baseX[i]), _mm_mul_ps(ax, s));
+        x = _mm_sub_ps(x, _mm_cvtepi32_ps(_mm_cvttps_epi32(x)));             // fract (x > -1)
+        x = _mm_add_ps(x, _mm_and_ps(_mm_cmplt_ps(x, _mm_setzero_ps()), one));
+        __m128 y = _mm_add_ps(_mm_loadu_ps(&e.baseY[i]), _mm_mul_ps(ay, sin4(_mm_mul_ps(seven, t))));
+        __m128 a = _mm_mul_ps(aa, _mm_add_ps(half, _mm_mul_ps(half, s)));
+
+        // interleave to (x, y) and (r, g, b, a) for the vertex arrays
+        _mm_storeu_ps(&e.xy[i * 2 + 0], _mm_unpacklo_ps(x, y));
+        _mm_storeu_ps(&e.xy[i * 2 + 4], _mm_unpackhi_ps(x, y));
+        __m128 rg = _mm_unpacklo_ps(r, g), ba0 = _mm_unpacklo_ps(b, a), ba1 = _mm_unpackhi_ps(b, a);
+        _mm_storeu_ps(&e.rgba[i * 4 + 0], _mm_movelh_ps(rg, ba0));
+        _mm_storeu_ps(&e.rgba[i * 4 + 4], _mm_movehl_ps(ba0, rg));
+        _mm_storeu_ps(&e.rgba[i * 4 + 8], _mm_movelh_ps(rg, ba1));
+        _mm_storeu_ps(&e.rgba[i * 4 + 12], _mm_movehl_ps(ba1, rg));
+    }
+#endif
+    for (; i < n; ++i) {
+        float t = time * 0.6f * e.speed[i] + e.phase[i];
+        float s = std::sin(t);
+        float x = e.baseX[i] + 0.02f * s;
+        e.xy[i * 2 + 0] = x - std::floor(x);
+        e.xy[i * 2 + 1] = e.baseY[i] + 0.05f * std::sin(t * 0.7f);
+        e.rgba[i * 4 + 0] = 1.0f; e.rgba[i * 4 + 1] = 0.6f; e.rgba[i * 4 + 2] = 0.2f;
+        e.rgba[i * 4 + 3] = 0.65f * (0.5f + 0.5f * s);
+    }
+}
+
 static void drawEmbers() {
-    const int count = 60;
+    if (gEmbers.count <= 0) return;
+    animateEmbers(gNezhaBG.time);
+
+    glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
     glEnable(GL_POINT_SMOOTH);
     glPointSize(2.0f);
-    glBegin(GL_POINTS);
-    for (int i = 0; i < count; ++i) {
-        float rx = frand();
-        float ry = frand() * 0.5f + 0.05f;
-        float t = gNezhaBG.time * 0.6f + i;
-        float x = std::fmod(rx + 0.02f * std::sin(t + i), 1.0f);
-        float y = ry + 0.05f * std::sin(t * 0.7f + i);
-        glColor4f(1.0f, 0.6f, 0.2f, 0.65f * (0.5f + 0.5f * std::sin(t + i)));
-        glVertex2f(x, y);
-    }
-    glEnd();
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    glVertexPointer(2, GL_FLOAT, 0, gEmbers.xy.data());
+    glColorPointer(4, GL_FLOAT, 0, gEmbers.rgba.data());
+    glDrawArrays(GL_POINTS, 0, gEmbers.count);
     glDisable(GL_POINT_SMOOTH);
+    glPopClientAttrib();
+}
+// Mountain silhouette: noise(u) = 0.03 sin(6u) + 0.02 sin(14u), periodic in
+// u with period pi. It is tabulated once as a triangle strip (base vertex,
+// top vertex per column) covering one period plus a screen width, and each
+// layer scrolls by drawing a 201-column window of it at its own offset.
+static const int   kMountainCols = 200;                      // columns per unit of u
+static const float kMountainPeriod = 3.14159265f;
+static const float kMountainBase = -8.0f;                    // below y = 0 for every layer (y0/h < 8)
+static std::vector<float> gMountainStrip;                    // x, y pairs
+
+static void buildMountainStrip() {
+    if (!gMountainStrip.empty()) return;
+    const int cols = (int)(kMountainPeriod * kMountainCols) + kMountainCols + 2;
+    gMountainStrip.resize((size_t)cols * 4);
+    for (int i = 0; i < cols; ++i) {
+        float u = (float)i / kMountainCols;
+        float noise = std::sin(u * 6.0f) * 0.03f + std::sin(u * 14.0f) * 0.02f;
+        gMountainStrip[i * 4 + 0] = u; gMountainStrip[i * 4 + 1] = kMountainBase;
+        gMountainStrip[i * 4 + 2] = u; gMountainStrip[i * 4 + 3] = noise;
+    }
+}
+
+struct MountainLayer { float y0, h, r, g, b, alpha, speed; };
+static const MountainLayer kMountainLayers[3] = {   // back to front
+    { 0.25f, 0.08f, 0.10f, 0.08f, 0.16f, 0.35f, 0.02f },
+    { 0.20f, 0.09f, 0.14f, 0.09f, 0.18f, 0.45f, 0.04f },
+    { 0.16f, 0.11f, 0.18f, 0.10f, 0.20f, 0.60f, 0.06f },
+};
+
+static float mountainPhase(const MountainLayer& m) {
+    float phase = std::fmod(gNezhaBG.time * m.speed, kMountainPeriod);
+    return phase < 0.0f ? phase + kMountainPeriod : phase;
+}
+
+static void drawMountainsLayer(const MountainLayer& m) {
+    const float phase = mountainPhase(m);
+    const int first = (int)(phase * kMountainCols);   // column at or just left of the screen edge
+
+    glColor4f(m.r, m.g, m.b, m.alpha);
+    glPushMatrix();
+    glTranslatef(-phase, m.y0, 0.0f);
+    glScalef(1.0f, m.h, 1.0f);
+    glDrawArrays(GL_TRIANGLE_STRIP, first * 2, (kMountainCols + 2) * 2);
+    glPopMatrix();
+}
+
+// ------------- single-pass shader background -------------
+// The whole backdrop (sky, sun glow, clouds, halo, ribbons and the three
+// mountain layers) evaluated per pixel in one fullscreen quad. Each layer
+// is the closed form of the geometry above, blended in the same order;
+// fans become radial falloffs. The embers still draw on top as points.
+static const char* kBackgroundVS = R"(#version 120
+void main() { gl_Position = gl_ModelViewProjectionMatrix * gl_Vertex; }
+)";
+
+static const char* kBackgroundFS = R"(#version 120
+uniform vec2  uViewport;
+uniform float uTime;
+uniform vec4  uCloud[12];         // x, y, scale, speed
+uniform float uCloudPhase[12];
+uniform vec4  uMountain[3];       // y0, h, scroll phase, alpha
+uniform vec3  uMountainColor[3];
+
+vec3 blendOver(vec3 dst, vec3 src, float a) { return mix(dst, src, clamp(a, 0.0, 1.0)); }
+
+// disc fan: aCenter at the centre falling linearly to 0 at radius r
+float disc(vec2 p, vec2 c, float r, float aCenter) {
+    float d = length(p - c) / r;
+    return d < 1.0 ? aCenter * (1.0 - d) : 0.0;
+}
+
+vec3 ribbon(vec3 col, vec2 p, float r0, float r1, float a0, float a1, float amp, float freq, float alpha) {
+    vec2 d = p - vec2(0.5, 0.58);
+    float a = atan(d.y, d.x);
+    if (a < 0.0) a += 6.2831853;
+    float u = (a - a0) / (a1 - a0);
+    if (u < 0.0 || u > 1.0) return col;
+    float wobble = sin(a * freq) * amp;
+    float t = (length(d) - (r0 + wobble)) / (r1 - r0);   // 0 inner edge, 1 outer edge
+    if (t < 0.0 || t > 1.0) return col;
+    float aInner = alpha * (0.4 + 0.6 * u), aOuter = alpha * (0.6 + 0.4 * (1.0 - u));
+    return blendOver(col, vec3(0.95, 0.15, 0.10), mix(aInner, aOuter, t));
+}
+
+void main() {
+    vec2 p = gl_FragCoord.xy / uViewport;
+
+    // sky gradient
+    vec3 top = vec3(0.08, 0.07, 0.16), mid = vec3(0.35, 0.10, 0.32), bot = vec3(0.95, 0.42, 0.12);
+    vec3 col = p.y < 0.55 ? mix(bot, mid, p.y / 0.55) : mix(mid, top, (p.y - 0.55) / 0.45);
+
+    // sun glow
+    col = blendOver(col, vec3(1.0), disc(p, vec2(0.72, 0.78), 0.18, 0.85));
+    col = blendOver(col, vec3(1.0), disc(p, vec2(0.72, 0.78), 0.32, 0.25));
+
+    // clouds: five overlapping puffs each
+    for (int i = 0; i < 12; ++i) {
+        float s = uCloud[i].z;
+        float x = mod(uCloud[i].x + uTime * uCloud[i].w, 1.3) - 0.15;
+        float y = uCloud[i].y + 0.01 * sin(uTime * 0.3 + uCloudPhase[i]);
+        if (abs(p.x - x) > s * 1.4 || abs(p.y - y) > s * 1.1) continue;
+        col = blendOver(col, vec3(1.0), disc(p, vec2(x, y), s * 0.9, 0.12));
+        col = blendOver(col, vec3(1.0), disc(p, vec2(x - s * 0.5, y), s * 0.7, 0.12));
+        col = blendOver(col, vec3(1.0), disc(p, vec2(x + s * 0.55, y), s * 0.75, 0.12));
+        col = blendOver(col, vec3(1.0), disc(p, vec2(x - s * 0.15, y + s * 0.35), s * 0.65, 0.12));
+        col = blendOver(col, vec3(1.0), disc(p, vec2(x + s * 0.25, y + s * 0.30), s * 0.6, 0.12));
+    }
+
+    // lotus halo: 18 half-ellipse petals
+    vec2 h = p - vec2(0.5, 0.58);
+    if (dot(h, h) < 0.0144) {
+        for (int i = 0; i < 18; ++i) {
+            float a = 6.2831853 * float(i) / 18.0;
+            float r = 0.10 + 0.02 * sin(uTime * 0.8 + float(i));
+            vec2 dir = vec2(cos(a), sin(a));
+            vec2 l = vec2(dot(h, dir), dot(h, vec2(-dir.y, dir.x)));
+            float rho = length(vec2(l.x / r, l.y / (0.55 * r)));
+            if (l.y < 0.0 || rho >= 1.0) continue;
+            col = blendOver(col, mix(vec3(1.0, 0.9, 0.6), vec3(1.0, 0.8, 0.3), rho), 0.14 * (1.0 - rho));
+        }
+    }
+
+    // ribbons
+    col = ribbon(col, p, 0.22, 0.27, 3.3161, 6.1086, 0.010, 6.0, 0.55);
+    col = ribbon(col, p, 0.28, 0.33, 3.4361, 6.2286, 0.012, 7.5, 0.35);
+
+    // mountains, back to front
+    for (int i = 0; i < 3; ++i) {
+        float x = p.x + uMountain[i].z;
+        float top = uMountain[i].x + uMountain[i].y * (sin(x * 6.0) * 0.03 + sin(x * 14.0) * 0.02);
+        if (p.y <= top) col = blendOver(col, uMountainColor[i], uMountain[i].w);
+    }
+
+    gl_FragColor = vec4(col, 1.0);
 }
-static void drawMountainsLayer(float y0, float h, float r, float g, float b, float alpha, float speed) {
-    glColor4f(r, g, b, alpha);
-    glBegin(GL_TRIANGLE_STRIP);
-    for (int i = 0; i <= 200; ++i) {
-        float u = (float)i / 200.0f;
-        float w = gNezhaBG.time * speed;
-        float noise = std::sin((u + w) * 6.0f) * 0.03f
-            + std::sin((u * 2.0f + w * 1.3f) * 7.0f) * 0.02f;
-        float y = y0 + noise * h;
-        glVertex2f(u, 0.0f);
-        glVertex2f(u, y);
+)";
+
+struct BackgroundShader {
+    int state = -1;          // -1 untried, 0 unavailable, 1 ready
+    GLuint program = 0;
+    GLint viewportLoc = -1, timeLoc = -1, cloudLoc = -1, cloudPhaseLoc = -1;
+    GLint mountainLoc = -1, mountainColorLoc = -1;
+};
+static BackgroundShader gBGShader;
+
+static bool backgroundShaderReady() {
+    BackgroundShader& sh = gBGShader;
+    if (sh.state >= 0) return sh.state == 1;
+
+    sh.state = 0;
+    if (initGLExtensions() && glVersionAtLeast(2, 0)) {
+        sh.program = buildGLProgram(kBackgroundVS, kBackgroundFS);
+        if (sh.program) {
+            sh.viewportLoc = gGL.getUniformLocation(sh.program, "uViewport");
+            sh.timeLoc = gGL.getUniformLocation(sh.program, "uTime");
+            sh.cloudLoc = gGL.getUniformLocation(sh.program, "uCloud");
+            sh.cloudPhaseLoc = gGL.getUniformLocation(sh.program, "uCloudPhase");
+            sh.mountainLoc = gGL.getUniformLocation(sh.program, "uMountain");
+            sh.mountainColorLoc = gGL.getUniformLocation(sh.program, "uMountainColor");
+            sh.state = 1;
+        }
     }
+    std::printf("Background shader: %s\n", sh.state ? "ready" : "unavailable, using geometry");
+    return sh.state == 1;
+}
+
+static void drawShaderBackground() {
+    const BackgroundShader& sh = gBGShader;
+    GLint vp[4];
+    glGetIntegerv(GL_VIEWPORT, vp);
+
+    float cloud[kCloudCount * 4], cloudPhase[kCloudCount];
+    for (int i = 0; i < kCloudCount; ++i) {
+        cloud[i * 4 + 0] = gClouds[i].x;
+        cloud[i * 4 + 1] = gClouds[i].y;
+        cloud[i * 4 + 2] = gClouds[i].scale;
+        cloud[i * 4 + 3] = gClouds[i].speed;
+        cloudPhase[i] = gClouds[i].phase;
+    }
+    float mountain[3 * 4], mountainColor[3 * 3];
+    for (int i = 0; i < 3; ++i) {
+        const MountainLayer& m = kMountainLayers[i];
+        mountain[i * 4 + 0] = m.y0;
+        mountain[i * 4 + 1] = m.h;
+        mountain[i * 4 + 2] = mountainPhase(m);   // wrapped on the CPU, so float time never loses precision
+        mountain[i * 4 + 3] = m.alpha;
+        mountainColor[i * 3 + 0] = m.r; mountainColor[i * 3 + 1] = m.g; mountainColor[i * 3 + 2] = m.b;
+    }
+
+    gGL.useProgram(sh.program);
+    gGL.uniform2f(sh.viewportLoc, (float)vp[2], (float)vp[3]);
+    gGL.uniform1f(sh.timeLoc, gNezhaBG.time);
+    gGL.uniform4fv(sh.cloudLoc, kCloudCount, cloud);
+    gGL.uniform1fv(sh.cloudPhaseLoc, kCloudCount, cloudPhase);
+    gGL.uniform4fv(sh.mountainLoc, 3, mountain);
+    gGL.uniform3fv(sh.mountainColorLoc, 3, mountainColor);
+
+    glDisable(GL_BLEND);
+    glBegin(GL_QUADS);
+    glVertex2f(0, 0); glVertex2f(1, 0); glVertex2f(1, 1); glVertex2f(0, 1);
     glEnd();
+    glEnable(GL_BLEND);
+    gGL.useProgram(0);
+}
+
+static bool useShaderBackground() { return gNezhaBG.shaderMode && backgroundShaderReady(); }
+
+void toggleNezhaShaderBackground() {
+    gNezhaBG.shaderMode = !gNezhaBG.shaderMode;
+    std::printf("Background: %s\n", useShaderBackground() ? "single fullscreen shader" : "geometry layers");
 }
 
 // ------------- API -------------
 void updateNezhaBackground(float dt) { if (gNezhaBG.enabled) gNezhaBG.time += dt; }
 
+void resizeNezhaBackground(int w, int h) {
+    gBGCache.w = w;
+    gBGCache.h = h;
+    gBGCache.dirty = true;
+}
+
 void drawNezhaBackground() {
     if (!gNezhaBG.enabled) return;
     begin2D();
-    drawSkyGradient();
-    drawSunGlow();
-    drawClouds();
-    drawLotusHaloAndRibbons();
+    if (useShaderBackground()) {
+        drawShaderBackground();   // includes the mountains
+        drawEmbers();
+        end2D();
+        return;
+    }
+
+    buildCircleTable();
+    const bool slowCached = gNezhaBG.slowLayerHz > 0.0f;
+    if (gNezhaBG.cacheStatic && drawBackgroundCache(slowCached)) {
+        if (!slowCached) { drawClouds(); drawLotusHalo(); drawRibbons(); }
+    }
+    else {
+        drawSkyGradient();
+        drawSunGlow();
+        drawClouds();
+        drawLotusHalo();
+        drawRibbons();
+    }
+    batch2DFlush();
     drawEmbers();
     end2D();
 }
 
 void drawNezhaBackdropMountains() {
-    if (!gNezhaBG.enabled) return;
+    if (!gNezhaBG.enabled || useShaderBackground()) return;
+    buildMountainStrip();
     begin2D();
-    drawMountainsLayer(0.25f, 0.08f, 0.10f, 0.08f, 0.16f, 0.35f, 0.02f);
-    drawMountainsLayer(0.20f, 0.09f, 0.14f, 0.09f, 0.18f, 0.45f, 0.04f);
-    drawMountainsLayer(0.16f, 0.11f, 0.18f, 0.10f, 0.20f, 0.60f, 0.06f);
+    glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glVertexPointer(2, GL_FLOAT, 0, gMountainStrip.data());
+    for (const MountainLayer& m : kMountainLayers) drawMountainsLayer(m);
+    glPopClientAttrib();
     end2D();
 }
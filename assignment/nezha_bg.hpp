@@ -4,6 +4,18 @@
 struct NezhaBGState {
     bool  enabled = true;
     float time = 0.0f;
+    int   emberCount = 60;    // runtime knob; the ember field grows to match
+
+    // Static layers (sky, sun glow) are baked into a window-sized texture on
+    // reshape and composited with one quad. With slowLayerHz > 0 the clouds,
+    // halo wobble and the ribbons over them are baked too and re-baked at
+    // that rate (in background time) instead of being drawn every frame.
+    bool  cacheStatic = true;
+    float slowLayerHz = 0.0f;   // setNezhaSlowLayerHz / F6
+
+    // Draw the backdrop (mountains included) as one fullscreen fragment
+    // program instead of the geometry layers; falls back when GLSL is missing.
+    bool  shaderMode = false;
 };
 
 extern NezhaBGState gNezhaBG;
@@ -12,3 +24,14 @@ void initNezhaBackground(int seed = 1337);
 void updateNezhaBackground(float dt);
 void drawNezhaBackground();
 void drawNezhaBackdropMountains();
+void resizeNezhaBackground(int w, int h);   // from reshape: re-bakes the cached layers
+void toggleNezhaShaderBackground();
+
+// Change the ember count (keeps existing embers, generates any new ones)
+void setNezhaEmberCount(int count);
+void cycleNezhaEmberCount();   // 60 -> 240 -> ... -> 15360 -> 60
+
+// Cache the clouds and halo and re-bake them `hz` times per background
+// second (0 = draw them every frame)
+void setNezhaSlowLayerHz(float hz);
+void cycleNezhaSlowLayerHz();  // every frame -> 30 -> 15 -> 5 Hz -> every frame
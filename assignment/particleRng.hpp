@@ -0,0 +1,16 @@
+#pragma once
+#include <cstdint>
+
+// xorshift32: tiny, fast, and owned per pool (no shared rand() state)
+struct ParticleRng {
+    uint32_t state = 0x9E3779B9u;
+
+    void seed(uint32_t s) { state = s ? s : 0x9E3779B9u; }
+    uint32_t next() {
+        uint32_t x = state;
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        return state = x;
+    }
+    float next01() { return (next() >> 8) * (1.0f / 16777216.0f); }           // [0, 1)
+    float range(float lo, float hi) { return lo + (hi - lo) * next01(); }
+};
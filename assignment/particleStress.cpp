@@ -0,0 +1,175 @@
+#include "particleStress.hpp"
+#include "particles.hpp"
+#include "jobPool.hpp"
+#include "gpuParticles.hpp"
+#include "animation.hpp"
+#include "meditation.hpp"
+#include "nezha_bg.hpp"
+#include "textureStreaming.hpp"
+#include "textureAtlas.hpp"
+#include <GL/freeglut.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+static bool gStressRequested = false;
+
+void parseParticleStressArgs(int& argc, char** argv) {
+    int out = 1;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--stress")) {
+            gStressRequested = true;
+        }
+        else if (!std::strcmp(argv[i], "--threads") && i + 1 < argc) {
+            setJobThreadCount(std::atoi(argv[++i]));
+            std::printf("Job pool: %d thread(s)\n", jobThreadCount());
+        }
+        else argv[out++] = argv[i];
+    }
+    argc = out;
+}
+
+// ---------- effects under test: each wraps the effect's own emitter ----------
+static bool spawnDragon(ParticlePool& p) { return spawnDragonFireParticle(p, 2.1f); } // peak fire reach
+static bool spawnWheel(ParticlePool& p)  { return spawnFireWheelSpark(p, 0.4f); }     // full-size wheel
+static bool spawnMote(ParticlePool& p)   { return spawnMeditationParticle(p); }
+
+struct StressEffect {
+    const char* name;
+    bool (*spawn)(ParticlePool& pool);
+    float riseAccel;     // the effect's step acceleration (y)
+    float spinRadians;   // per-step Y rotation (wheel sparks follow the wheel)
+};
+
+static const StressEffect kEffects[] = {
+    { "dragon fire",  spawnDragon, 0.0f, 0.0f },
+    { "wheel sparks", spawnWheel,  0.6f, 0.05f },
+    { "meditation",   spawnMote,   0.0f, 0.0f },
+};
+
+static const int kCounts[] = { 10000, 30000, 100000, 300000, 1000000 };
+static const int kFrames = 10;
+static const float kDt = 0.016f;
+
+typedef std::chrono::steady_clock Clock;
+static double msSince(Clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+// One simulated frame: advect, age/retire, refill what died
+static void simulateFrame(ParticlePool& pool, const StressEffect& fx) {
+    if (fx.spinRadians != 0.0f) rotateParticlesY(pool, fx.spinRadians);
+    stepParticles(pool, kDt, 0.0f, fx.riseAccel, 0.0f);
+    for (int k = pool.capacity - liveParticleCount(pool); k > 0; --k)
+        if (!fx.spawn(pool)) break;
+}
+
+static double timeSimulation(ParticlePool& pool, const StressEffect& fx, int threads) {
+    setJobThreadCount(threads);
+    const Clock::time_point t0 = Clock::now();
+    for (int f = 0; f < kFrames; ++f) simulateFrame(pool, fx);
+    return msSince(t0) / kFrames;
+}
+
+// Compute-shader path: glFinish so the dispatches are inside the timing
+static double timeGpuSimulation(ParticlePool& pool, const StressEffect& fx) {
+    simulateFrame(pool, fx);   // first step moves the pool onto the GPU
+    glFinish();
+    const Clock::time_point t0 = Clock::now();
+    for (int f = 0; f < kFrames; ++f) simulateFrame(pool, fx);
+    glFinish();
+    return msSince(t0) / kFrames;
+}
+
+static void setStressCamera() {
+    const int w = glutGet(GLUT_WINDOW_WIDTH), h = glutGet(GLUT_WINDOW_HEIGHT);
+    glViewport(0, 0, w, h);
+    glMatrixMode(GL_PROJECTION);
+    glLoadIdentity();
+    gluPerspective(45.0, h > 0 ? (double)w / h : 1.0, 0.1, 100.0);
+    glMatrixMode(GL_MODELVIEW);
+    glLoadIdentity();
+    gluLookAt(0.0, 0.5, 6.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0);
+}
+
+template <typename Draw>
+static double timeRender(Draw draw) {
+    glFinish();
+    const Clock::time_point t0 = Clock::now();
+    for (int f = 0; f < kFrames; ++f) {
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        draw();
+        glFinish();   // include the GL work, not just the submit
+    }
+    return msSince(t0) / kFrames;
+}
+
+bool runParticleStressIfRequested() {
+    if (!gStressRequested) return false;
+
+    // startup texture decodes run on background threads: let them finish so
+    // they don't steal cores from the timed loops
+    finishStreamedTextures();
+    while (textureAtlasPending() && !uploadTextureAtlas())
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    const int threads = jobThreadCount();
+    const bool savedGpu = gGpuParticles;
+    const bool gpu = gpuParticlesAvailable();
+    const int kEffectCount = sizeof(kEffects) / sizeof(kEffects[0]);
+    int crossover[kEffectCount];   // first count where the GPU frame beats the CPU one
+    for (int e = 0; e < kEffectCount; ++e) crossover[e] = 0;
+
+    std::printf("\n=== PARTICLE STRESS (%d frames per count, %d thread(s)) ===\n", kFrames, threads);
+    std::printf("%-13s %9s %10s %10s %8s %10s %10s %10s\n",
+        "effect", "count", "sim 1T", "sim NT", "speedup", "render", "gpu sim", "gpu rend");
+
+    setStressCamera();
+    for (int count : kCounts) {
+        for (int e = 0; e < kEffectCount; ++e) {
+            const StressEffect& fx = kEffects[e];
+            ParticlePool pool;
+            gGpuParticles = false;
+            initParticlePool(pool, count, 0x5EED1234u);
+            while (fx.spawn(pool)) {}
+
+            const double sim1 = timeSimulation(pool, fx, 1);
+            const double simN = timeSimulation(pool, fx, threads);
+            const double render = timeRender([&] { drawParticleBillboards(pool); });
+
+            double gpuSim = 0.0, gpuRender = 0.0;
+            if (gpu) {
+                gGpuParticles = true;
+                gpuSim = timeGpuSimulation(pool, fx);
+                gpuRender = timeRender([&] { drawParticleBillboards(pool); });
+                if (!crossover[e] && gpuSim + gpuRender < simN + render) crossover[e] = count;
+            }
+            releaseGpuParticles(pool);
+
+            std::printf("%-13s %9d %10.3f %10.3f %7.2fx %10.3f", fx.name, count, sim1, simN,
+                simN > 0.0 ? sim1 / simN : 0.0, render);
+            if (gpu) std::printf(" %10.3f %10.3f\n", gpuSim, gpuRender);
+            else     std::printf(" %10s %10s\n", "-", "-");
+        }
+
+        // embers animate inside their draw, so there is only a render column
+        const int savedEmbers = gNezhaBG.emberCount;
+        setNezhaEmberCount(count);
+        const double render = timeRender([] { drawNezhaBackground(); });
+        std::printf("%-13s %9d %10s %10s %8s %10.3f %10s %10s\n", "embers", count, "-", "-", "-", render, "-", "-");
+        setNezhaEmberCount(savedEmbers);
+    }
+
+    if (gpu) {
+        for (int e = 0; e < kEffectCount; ++e) {
+            if (crossover[e]) std::printf("%-13s compute shader faster from %d particles\n", kEffects[e].name, crossover[e]);
+            else              std::printf("%-13s CPU faster at every count tested\n", kEffects[e].name);
+        }
+    }
+    std::printf("(times are ms per frame)\n");
+    std::printf("==========================================================\n");
+    gGpuParticles = savedGpu;
+    return true;
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+// ---------------- Particle stress mode ----------------
+// `--stress` runs a one-shot benchmark after the window and textures are up,
+// then exits: each particle effect (dragon fire, fire-wheel sparks,
+// meditation motes, background embers) is driven at 10k .. 1M particles with
+// its own emitter parameters, and the average simulation time (one thread
+// vs. the job pool) and render time per frame are printed per count. On GL
+// 4.3 contexts the compute-shader path is timed alongside, with the count
+// where it starts to win.
+// `--threads <n>` caps the job pool for normal runs as well.
+
+void parseParticleStressArgs(int& argc, char** argv);
+
+// Runs the benchmark if --stress was given. Returns true when it ran (the
+// caller should exit instead of entering the main loop).
+bool runParticleStressIfRequested();
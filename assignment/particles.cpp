@@ -0,0 +1,295 @@
+#include "particles.hpp"
+#include "utils.hpp"
+#include "jobPool.hpp"
+#include "gpuParticles.hpp"
+#include "transparentPass.hpp"
+#include <cstdio>
+#include <cmath>
+
+// Fixed partition for the threaded loops: each chunk owns its index range,
+// so workers never write the same element. Pools below one chunk run inline.
+static const int kParticleChunk = 4096;
+
+bool gGpuParticles = false;
+
+void toggleGpuParticles() {
+    gGpuParticles = !gGpuParticles;
+    if (gGpuParticles && !gpuParticlesAvailable()) gGpuParticles = false;
+    std::printf("Particle simulation: %s\n", gGpuParticles ? "compute shader" : "CPU");
+}
+
+// GPU while the switch is on, CPU otherwise (a pool leaving the GPU is reset)
+static bool useGpu(ParticlePool& pool) {
+    if (gGpuParticles && gpuParticlesAvailable()) return true;
+    if (pool.gpu) releaseGpuParticles(pool);
+    return false;
+}
+
+void initParticlePool(ParticlePool& pool, int capacity, uint32_t seed) {
+    releaseGpuParticles(pool);
+    pool.capacity = capacity;
+    pool.count = 0;
+    std::vector<float>* attrs[] = {
+        &pool.px, &pool.py, &pool.pz, &pool.vx, &pool.vy, &pool.vz,
+        &pool.life, &pool.maxLife, &pool.size, &pool.growth,
+        &pool.r, &pool.g, &pool.b, &pool.a
+    };
+    for (std::vector<float>* v : attrs) v->assign(capacity, 0.0f);
+    pool.rng.seed(seed);
+}
+
+bool spawnParticle(ParticlePool& pool, const ParticleSpawn& s) {
+    // on the GPU, spawns wait for the next step and may only fill dead ring slots
+    if (pool.count >= (pool.gpu ? gpuFreeSlots(pool) : pool.capacity)) return false;
+    const int i = pool.count++;
+    pool.px[i] = s.x;  pool.py[i] = s.y;  pool.pz[i] = s.z;
+    pool.vx[i] = s.vx; pool.vy[i] = s.vy; pool.vz[i] = s.vz;
+    pool.life[i] = s.life; pool.maxLife[i] = s.life;
+    pool.size[i] = s.size; pool.growth[i] = s.growth;
+    pool.r[i] = s.r; pool.g[i] = s.g; pool.b[i] = s.b; pool.a[i] = s.a;
+    return true;
+}
+
+void clearParticles(ParticlePool& pool) {
+    releaseGpuParticles(pool);
+    pool.count = 0;
+}
+
+int liveParticleCount(const ParticlePool& pool) {
+    return pool.gpu ? gpuLiveParticles(pool) : pool.count;
+}
+
+static void moveParticle(ParticlePool& p, int from, int to) {
+    p.px[to] = p.px[from]; p.py[to] = p.py[from]; p.pz[to] = p.pz[from];
+    p.vx[to] = p.vx[from]; p.vy[to] = p.vy[from]; p.vz[to] = p.vz[from];
+    p.life[to] = p.life[from]; p.maxLife[to] = p.maxLife[from];
+    p.size[to] = p.size[from]; p.growth[to] = p.growth[from];
+    p.r[to] = p.r[from]; p.g[to] = p.g[from]; p.b[to] = p.b[from]; p.a[to] = p.a[from];
+}
+
+struct StepJob {
+    ParticlePool* pool;
+    float dt, ax, ay, az;
+};
+
+static void integrateRange(int begin, int end, void* user) {
+    const StepJob& job = *(const StepJob*)user;
+    ParticlePool& p = *job.pool;
+    const float dt = job.dt;
+    const float ax = job.ax * dt, ay = job.ay * dt, az = job.az * dt;
+    float* vx = p.vx.data(); float* vy = p.vy.data(); float* vz = p.vz.data();
+    float* px = p.px.data(); float* py = p.py.data(); float* pz = p.pz.data();
+    float* life = p.life.data();
+    float* size = p.size.data();
+    const float* growth = p.growth.data();
+
+    // straight-line loops over each attribute (vectorise cleanly)
+    for (int i = begin; i < end; ++i) { vx[i] += ax; vy[i] += ay; vz[i] += az; }
+    for (int i = begin; i < end; ++i) { px[i] += vx[i] * dt; py[i] += vy[i] * dt; pz[i] += vz[i] * dt; }
+    for (int i = begin; i < end; ++i) { life[i] -= dt; size[i] += growth[i] * dt; }
+}
+
+void stepParticles(ParticlePool& p, float dt, float ax, float ay, float az) {
+    if (useGpu(p)) { gpuStepParticles(p, dt, ax, ay, az); return; }
+
+    StepJob job = { &p, dt, ax, ay, az };
+    parallelFor(p.count, kParticleChunk, integrateRange, &job);
+
+    // retire (serial, it moves particles across chunks): swap the last live
+    // particle into each dead slot
+    const float* life = p.life.data();
+    int i = 0;
+    while (i < p.count) {
+        if (life[i] > 0.0f) { ++i; continue; }
+        moveParticle(p, --p.count, i);
+    }
+}
+
+struct RotateJob {
+    ParticlePool* pool;
+    float c, s;
+};
+
+static void rotateRange(int begin, int end, void* user) {
+    const RotateJob& job = *(const RotateJob*)user;
+    ParticlePool& p = *job.pool;
+    const float c = job.c, s = job.s;
+    float* px = p.px.data(); float* pz = p.pz.data();
+    float* vx = p.vx.data(); float* vz = p.vz.data();
+    for (int i = begin; i < end; ++i) {
+        const float x = px[i], z = pz[i];
+        px[i] = c * x + s * z;
+        pz[i] = -s * x + c * z;
+    }
+    for (int i = begin; i < end; ++i) {
+        const float x = vx[i], z = vz[i];
+        vx[i] = c * x + s * z;
+        vz[i] = -s * x + c * z;
+    }
+}
+
+void rotateParticlesY(ParticlePool& p, float radians) {
+    if (p.gpu) { gpuSpinParticles(p, radians); return; }  // turns in the next step
+    RotateJob job = { &p, std::cos(radians), std::sin(radians) };
+    parallelFor(p.count, kParticleChunk, rotateRange, &job);
+}
+
+void initParticleEmitter(ParticleEmitter& e, int capacity, uint32_t seed) {
+    initParticlePool(e.pool, capacity, seed);
+    e.carry = 0.0f;
+}
+
+int emitterSpawnBudget(ParticleEmitter& e, float ratePerSecond, float dt) {
+    if (ratePerSecond <= 0.0f) { e.carry = 0.0f; return 0; }
+    e.carry += ratePerSecond * dt;
+    const int n = (int)e.carry;
+    e.carry -= (float)n;
+    return n;
+}
+
+// ---------- rendering ----------
+// Soft round sprite generated once (white, alpha falls off to the rim)
+GLuint particleSpriteTexture() {
+    static GLuint tex = 0;
+    if (tex) return tex;
+
+    const int N = 32;
+    unsigned char texels[N * N * 2];
+    for (int y = 0; y < N; ++y) {
+        for (int x = 0; x < N; ++x) {
+            float dx = (x + 0.5f) / N * 2.0f - 1.0f;
+            float dy = (y + 0.5f) / N * 2.0f - 1.0f;
+            float d = 1.0f - std::sqrt(dx * dx + dy * dy);
+            if (d < 0.0f) d = 0.0f;
+            texels[(y * N + x) * 2 + 0] = 255;
+            texels[(y * N + x) * 2 + 1] = (unsigned char)(255.0f * d * d * (3.0f - 2.0f * d));
+        }
+    }
+    glGenTextures(1, &tex);
+    glBindTexture(GL_TEXTURE_2D, tex);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_LUMINANCE_ALPHA, N, N, 0, GL_LUMINANCE_ALPHA, GL_UNSIGNED_BYTE, texels);
+    return tex;
+}
+
+// Reused between frames so a steady-state draw never allocates
+static std::vector<float> gQuadPos, gQuadUV, gQuadColor;
+
+struct BillboardJob {
+    const ParticlePool* pool;
+    float right[3], up[3];
+};
+
+// Four corners per particle; particle i owns vertices [4i, 4i + 4)
+static void expandBillboards(int begin, int end, void* user) {
+    const BillboardJob& job = *(const BillboardJob*)user;
+    const ParticlePool& p = *job.pool;
+    const float rx = job.right[0], ry = job.right[1], rz = job.right[2];
+    const float ux = job.up[0], uy = job.up[1], uz = job.up[2];
+
+    static const float kCornerU[4] = { 0, 1, 1, 0 };
+    static const float kCornerV[4] = { 0, 0, 1, 1 };
+    static const float kCornerX[4] = { -1, 1, 1, -1 };
+    static const float kCornerY[4] = { -1, -1, 1, 1 };
+
+    float* pos = gQuadPos.data() + (size_t)begin * 12;
+    float* uv = gQuadUV.data() + (size_t)begin * 8;
+    float* col = gQuadColor.data() + (size_t)begin * 16;
+    for (int i = begin; i < end; ++i) {
+        const float s = p.size[i];
+        const float alpha = p.a[i] * (p.life[i] / p.maxLife[i]);
+        for (int c = 0; c < 4; ++c) {
+            const float sx = kCornerX[c] * s, sy = kCornerY[c] * s;
+            *pos++ = p.px[i] + rx * sx + ux * sy;
+            *pos++ = p.py[i] + ry * sx + uy * sy;
+            *pos++ = p.pz[i] + rz * sx + uz * sy;
+            *uv++ = kCornerU[c];
+            *uv++ = kCornerV[c];
+            *col++ = p.r[i]; *col++ = p.g[i]; *col++ = p.b[i]; *col++ = alpha;
+        }
+    }
+}
+
+// Geometry only: expand for the camera axes of `modelview` and draw.
+// Client arrays are saved and restored; server state is the caller's.
+static void emitBillboards(const ParticlePool& p, const GLfloat* m) {
+    // Camera right/up in the current object space: rows of the modelview.
+    // Normalising removes any uniform scale so sizes stay in object units.
+    float rx = m[0], ry = m[4], rz = m[8];
+    float ux = m[1], uy = m[5], uz = m[9];
+    const float rl = std::sqrt(rx * rx + ry * ry + rz * rz);
+    const float ul = std::sqrt(ux * ux + uy * uy + uz * uz);
+    if (rl > 0.0f) { rx /= rl; ry /= rl; rz /= rl; }
+    if (ul > 0.0f) { ux /= ul; uy /= ul; uz /= ul; }
+
+    int quads = 0;
+    if (p.gpu) {
+        // expanded on the GPU straight into a vertex buffer (left bound)
+        const float right[3] = { rx, ry, rz }, up[3] = { ux, uy, uz };
+        quads = gpuExpandBillboards(p, right, up);
+        if (quads == 0) return;
+    }
+    else {
+        quads = p.count;
+        gQuadPos.resize((size_t)quads * 12);
+        gQuadUV.resize((size_t)quads * 8);
+        gQuadColor.resize((size_t)quads * 16);
+
+        BillboardJob job = { &p, { rx, ry, rz }, { ux, uy, uz } };
+        parallelFor(quads, kParticleChunk, expandBillboards, &job);
+    }
+
+    glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    if (p.gpu) {
+        const GLsizei stride = 9 * sizeof(float);   // interleaved xyz, uv, rgba
+        glVertexPointer(3, GL_FLOAT, stride, (const void*)0);
+        glTexCoordPointer(2, GL_FLOAT, stride, (const void*)(3 * sizeof(float)));
+        glColorPointer(4, GL_FLOAT, stride, (const void*)(5 * sizeof(float)));
+    }
+    else {
+        glVertexPointer(3, GL_FLOAT, 0, gQuadPos.data());
+        glTexCoordPointer(2, GL_FLOAT, 0, gQuadUV.data());
+        glColorPointer(4, GL_FLOAT, 0, gQuadColor.data());
+    }
+    glDrawArrays(GL_QUADS, 0, quads * 4);
+    countGLQuads(quads);
+    if (p.gpu) gpuUnbindQuads();
+    glPopClientAttrib();
+}
+
+void drawParticleBillboards(const ParticlePool& p) {
+    if (p.count <= 0 && !p.gpu) return;
+
+    GLfloat m[16];
+    glGetFloatv(GL_MODELVIEW_MATRIX, m);
+
+    glPushAttrib(GL_ENABLE_BIT | GL_CURRENT_BIT | GL_DEPTH_BUFFER_BIT | GL_COLOR_BUFFER_BIT | GL_TEXTURE_BIT);
+    glDisable(GL_LIGHTING);
+    glDisable(GL_CULL_FACE);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glDepthMask(GL_FALSE);
+    glEnable(GL_TEXTURE_2D);
+    glBindTexture(GL_TEXTURE_2D, particleSpriteTexture());
+    glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+
+    emitBillboards(p, m);
+
+    glPopAttrib();
+}
+
+static void drawQueuedBillboards(const TransparentItem& item) {
+    emitBillboards(*(const ParticlePool*)item.data, item.modelview);
+}
+
+void queueParticleBillboards(const ParticlePool& p, float ax, float ay, float az) {
+    if (p.count <= 0 && !p.gpu) return;
+    TransparentItem& item = queueTransparent(ax, ay, az, BLEND_ALPHA, particleSpriteTexture(), drawQueuedBillboards);
+    item.data = &p;
+}
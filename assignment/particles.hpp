@@ -0,0 +1,85 @@
+#pragma once
+#include <GL/freeglut.h>
+#include <cstdint>
+#include <vector>
+#include "particleRng.hpp"
+
+// ---------------- Pooled particle system ----------------
+// Structure-of-arrays pool: every attribute lives in its own contiguous array
+// so the simulation step is a handful of tight loops, and the pool is sized
+// once up front (no per-frame allocation). Dead particles are swap-removed, so
+// [0, count) is always the live set. Rendering is one batched draw of
+// camera-facing textured quads. Pools larger than one chunk are stepped and
+// expanded on the job pool (jobPool.hpp), one fixed index range per task.
+
+struct GpuParticleMirror;   // gpuParticles.cpp
+
+struct ParticlePool {
+    int capacity = 0;
+    int count = 0;                     // live particles are [0, count)
+
+    std::vector<float> px, py, pz;     // position
+    std::vector<float> vx, vy, vz;     // velocity
+    std::vector<float> life, maxLife;  // seconds remaining / at spawn
+    std::vector<float> size, growth;   // half-width, growth per second
+    std::vector<float> r, g, b, a;     // colour at spawn (alpha fades with life)
+
+    ParticleRng rng;
+    GpuParticleMirror* gpu = nullptr;  // set while simulated on the GPU (gpuParticles.hpp)
+
+    // owns `gpu` (freed by releaseGpuParticles), so never copied
+    ParticlePool() = default;
+    ParticlePool(const ParticlePool&) = delete;
+    ParticlePool& operator=(const ParticlePool&) = delete;
+};
+
+// Everything spawn needs; the emitter fills one in and calls spawnParticle
+struct ParticleSpawn {
+    float x = 0, y = 0, z = 0;
+    float vx = 0, vy = 0, vz = 0;
+    float life = 1.0f;
+    float size = 0.1f, growth = 0.0f;
+    float r = 1, g = 1, b = 1, a = 1;
+};
+
+// A pool plus the fractional spawn carried between steps, so a rate of
+// e.g. 90/s emits 1 or 2 per 16ms frame and averages out exactly.
+struct ParticleEmitter {
+    ParticlePool pool;
+    float carry = 0.0f;
+};
+
+// Runtime switch: simulate and draw pools with compute shaders when the
+// context supports them. Turning it off drops the particles held on the GPU.
+extern bool gGpuParticles;
+void toggleGpuParticles();
+
+void initParticlePool(ParticlePool& pool, int capacity, uint32_t seed);
+bool spawnParticle(ParticlePool& pool, const ParticleSpawn& s); // false when full
+void clearParticles(ParticlePool& pool);
+int  liveParticleCount(const ParticlePool& pool);   // count, or the GPU estimate
+
+// Integrate positions, apply acceleration (ax, ay, az), age and retire.
+void stepParticles(ParticlePool& pool, float dt, float ax = 0.0f, float ay = 0.0f, float az = 0.0f);
+
+// Rigidly rotate every particle (position and velocity) about the local Y
+// axis, e.g. to carry particles round with a spinning emitter.
+void rotateParticlesY(ParticlePool& pool, float radians);
+
+void initParticleEmitter(ParticleEmitter& e, int capacity, uint32_t seed);
+
+// How many particles to spawn this step at `ratePerSecond` (resets the carry
+// when the rate drops to zero).
+int  emitterSpawnBudget(ParticleEmitter& e, float ratePerSecond, float dt);
+
+// One draw call for the whole pool in the current modelview space.
+// Quads face the camera; alpha = spawn alpha * remaining life fraction.
+void drawParticleBillboards(const ParticlePool& pool);
+
+// The soft round sprite the billboards use (white, alpha falls to the rim)
+GLuint particleSpriteTexture();
+
+// Same draw, deferred to the transparent pass (transparentPass.hpp) and
+// sorted by the anchor point (ax, ay, az) in the current modelview space.
+// The pool must stay alive until the pass is flushed.
+void queueParticleBillboards(const ParticlePool& pool, float ax = 0.0f, float ay = 0.0f, float az = 0.0f);
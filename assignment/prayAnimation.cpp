@@ -2,7 +2,11 @@
 #include <cmath>
 #include "animation.hpp"
 #include "utils.hpp"
+#include "easing.hpp"
+#include "animScheduler.hpp"
+#include "impostors.hpp"
 #include <GL/freeglut.h>
+#include <algorithm>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -25,7 +29,7 @@ void updateRightLegLiftAnimation() {
         rightLegLiftAnim.legLiftProgress = phase;
         rightLegLiftAnim.legLiftHold = 0.0f;
 
-        float smoothPhase = phase * phase * (3.0f - 2.0f * phase);
+        float smoothPhase = smooth01(phase);
         rightLegLiftAnim.rightHipFlexion = smoothPhase * 45.0f;
         rightLegLiftAnim.rightKneeFlexion = smoothPhase * 60.0f;
     }
@@ -66,6 +70,7 @@ void triggerRightLegLiftAnimation() {
 
     rightLegLiftAnim.rightHipFlexion = 0.0f;
     rightLegLiftAnim.rightKneeFlexion = 0.0f;
+    scheduleAnimation(ANIMSYS_LEG_LIFT);
 }
 
 void toggleRightToeLift() {
@@ -91,24 +96,24 @@ void toggleRightStraightLegLift() {
         rightLegLiftAnim.straightLegLowering = true;
         rightLegLiftAnim.straightLegTime = 0.0f;
     }
+    scheduleAnimation(ANIMSYS_STRAIGHT_LEG);
 }
 
 void updateRightStraightLegLift() {
     const float dt = 0.016f;
-    auto smooth = [](float t) { return t * t * (3.0f - 2.0f * t); };
 
     if (rightLegLiftAnim.straightLegLiftActive && !rightLegLiftAnim.straightLegLowering) {
         rightLegLiftAnim.straightLegTime += dt;
         float t = rightLegLiftAnim.straightLegTime / rightLegLiftAnim.straightLegDurationUp;
         if (t > 1.0f) t = 1.0f;
-        float eased = smooth(t);
+        float eased = smooth01(t);
         rightLegLiftAnim.straightLegAnimAngleDeg = eased * rightLegLiftAnim.straightLegLiftAngleDeg;
     }
     else if (rightLegLiftAnim.straightLegLowering) {
         rightLegLiftAnim.straightLegTime += dt;
         float t = rightLegLiftAnim.straightLegTime / rightLegLiftAnim.straightLegDurationUp;
         if (t > 1.0f) t = 1.0f;
-        float eased = smooth(t);
+        float eased = smooth01(t);
         rightLegLiftAnim.straightLegAnimAngleDeg = (1.0f - eased) * rightLegLiftAnim.straightLegLiftAngleDeg;
         if (t >= 1.0f) {
             rightLegLiftAnim.straightLegLowering = false;
@@ -117,7 +122,41 @@ void updateRightStraightLegLift() {
     }
 }
 
-static inline float smoothstep01(float t) { return t * t * (3.0f - 2.0f * t); }
+// ---------------- Kung Fu kick channels ----------------
+// The kick is a chain of keyframe poses; each phase is one lerpN between two
+// of them rather than eight hand-blended assignments.
+enum {
+    KICK_FORWARD, KICK_ABDUCTION, KICK_TORSO_YAW, KICK_TORSO_SIDE,
+    KICK_HEAD_YAW, KICK_LEFT_ARM, KICK_RIGHT_ARM, KICK_FLY,
+    KICK_CHANNELS
+};
+
+static float KungFuKickState::* const kKickChannels[KICK_CHANNELS] = {
+    &KungFuKickState::forwardAngleDeg, &KungFuKickState::abductionDeg,
+    &KungFuKickState::torsoYawDeg, &KungFuKickState::torsoSideBendDeg,
+    &KungFuKickState::headYawDeg, &KungFuKickState::leftArmRaiseDeg,
+    &KungFuKickState::rightArmRaiseDeg, &KungFuKickState::flyHeight
+};
+
+// Upper body channels scaled by w (0 = neutral, 1 = full kick twist)
+static void setKickUpperBody(float* pose, float w) {
+    pose[KICK_TORSO_YAW] = w * kungFuKick.targetTorsoYaw;
+    pose[KICK_TORSO_SIDE] = w * kungFuKick.targetTorsoSide;
+    pose[KICK_HEAD_YAW] = w * kungFuKick.targetHeadYaw;
+    pose[KICK_LEFT_ARM] = w * kungFuKick.targetLeftArmRaise;
+    pose[KICK_RIGHT_ARM] = w * kungFuKick.targetRightArmRaise;
+}
+
+static void setKickPose(float* pose, float forward, float abduction, float upperBody, float fly) {
+    pose[KICK_FORWARD] = forward;
+    pose[KICK_ABDUCTION] = abduction;
+    setKickUpperBody(pose, upperBody);
+    pose[KICK_FLY] = fly * kungFuKick.flyHeightMax;
+}
+
+static void writeKickChannels(const float* v) {
+    for (int i = 0; i < KICK_CHANNELS; ++i) kungFuKick.*kKickChannels[i] = v[i];
+}
 
 void triggerKungFuKick() {
     kungFuKick = KungFuKickState();
@@ -125,6 +164,7 @@ void triggerKungFuKick() {
     rightLegLiftAnim.straightLegLiftActive = false;
     rightLegLiftAnim.straightLegLowering = false;
     rightLegLiftAnim.toeLiftActive = false;
+    scheduleAnimation(ANIMSYS_KUNG_FU_KICK);
 }
 
 void updateKungFuKickAnimation() {
@@ -139,104 +179,83 @@ void updateKungFuKickAnimation() {
     float p4 = p3 + kungFuKick.phase4Dur;
     float p5 = p4 + kungFuKick.holdDur;
 
-    if (t <= p1) {
-        float u = smoothstep01(t / p1);
-        kungFuKick.forwardAngleDeg = u * kungFuKick.targetForward1;
-        kungFuKick.abductionDeg = 0.0f;
-        kungFuKick.torsoYawDeg = 0.0f;
-        kungFuKick.torsoSideBendDeg = 0.0f;
-        kungFuKick.headYawDeg = 0.0f;
-        kungFuKick.leftArmRaiseDeg = 0.0f;
-        kungFuKick.rightArmRaiseDeg = 0.0f;
-        kungFuKick.flyHeight = u * (0.40f * kungFuKick.flyHeightMax);
-    }
-    else if (t <= p2) {
-        float u = smoothstep01((t - p1) / (p2 - p1));
-        kungFuKick.forwardAngleDeg = kungFuKick.targetForward1 + u * kungFuKick.swingForwardExtra;
-        kungFuKick.abductionDeg = u * kungFuKick.targetAbduction;
-
-        const float pre = 0.60f;
-        kungFuKick.torsoYawDeg = u * (pre * kungFuKick.targetTorsoYaw);
-        kungFuKick.torsoSideBendDeg = u * (pre * kungFuKick.targetTorsoSide);
-        kungFuKick.headYawDeg = u * (pre * kungFuKick.targetHeadYaw);
-        kungFuKick.leftArmRaiseDeg = u * (pre * kungFuKick.targetLeftArmRaise);
-        kungFuKick.rightArmRaiseDeg = u * (pre * kungFuKick.targetRightArmRaise);
-
-        kungFuKick.flyHeight = (0.40f + 0.30f * u) * kungFuKick.flyHeightMax;
-    }
-    else if (t <= p3) {
-        float u = smoothstep01((t - p2) / (p3 - p2));
-        kungFuKick.forwardAngleDeg = (1.0f - u) * kungFuKick.targetForward1 + u * kungFuKick.targetBack;
-        kungFuKick.abductionDeg = (1.0f - u) * kungFuKick.targetAbduction;
-
-        const float pre = 0.60f;
-        kungFuKick.torsoYawDeg = pre * kungFuKick.targetTorsoYaw;
-        kungFuKick.torsoSideBendDeg = pre * kungFuKick.targetTorsoSide;
-        kungFuKick.headYawDeg = pre * kungFuKick.targetHeadYaw;
-        kungFuKick.leftArmRaiseDeg = pre * kungFuKick.targetLeftArmRaise;
-        kungFuKick.rightArmRaiseDeg = pre * kungFuKick.targetRightArmRaise;
-
-        kungFuKick.flyHeight = (0.60f - 0.20f * u) * kungFuKick.flyHeightMax;
-    }
-    else if (t <= p4) {
-        float u = smoothstep01((t - p3) / (p4 - p3));
-        kungFuKick.forwardAngleDeg = (1.0f - u) * kungFuKick.targetBack + u * kungFuKick.targetForward2;
-        kungFuKick.abductionDeg = u * kungFuKick.targetAbduction;
-
-        const float pre = 0.60f;
-        kungFuKick.torsoYawDeg = ((1.0f - u) * pre + u) * kungFuKick.targetTorsoYaw;
-        kungFuKick.torsoSideBendDeg = ((1.0f - u) * pre + u) * kungFuKick.targetTorsoSide;
-        kungFuKick.headYawDeg = ((1.0f - u) * pre + u) * kungFuKick.targetHeadYaw;
-        kungFuKick.leftArmRaiseDeg = ((1.0f - u) * pre + u) * kungFuKick.targetLeftArmRaise;
-        kungFuKick.rightArmRaiseDeg = ((1.0f - u) * pre + u) * kungFuKick.targetRightArmRaise;
-
-        kungFuKick.flyHeight = ((1.0f - u) * 0.40f + u * 1.00f) * kungFuKick.flyHeightMax;
-    }
-    else if (t <= p5) {
-        kungFuKick.forwardAngleDeg = kungFuKick.targetForward2;
-        kungFuKick.abductionDeg = kungFuKick.targetAbduction;
-        kungFuKick.torsoYawDeg = kungFuKick.targetTorsoYaw;
-        kungFuKick.torsoSideBendDeg = kungFuKick.targetTorsoSide;
-        kungFuKick.headYawDeg = kungFuKick.targetHeadYaw;
-        kungFuKick.leftArmRaiseDeg = kungFuKick.targetLeftArmRaise;
-        kungFuKick.rightArmRaiseDeg = kungFuKick.targetRightArmRaise;
-        kungFuKick.flyHeight = kungFuKick.flyHeightMax;
-    }
-    else {
+    if (t > p5) {
         kungFuKick.isActive = false;
         kungFuKick.flyHeight = 0.0f;
+        return;
     }
+
+    // Keyframes: rest -> lift -> swing (pre-twist) -> back swing -> kick
+    const float pre = 0.60f;
+    const KungFuKickState& k = kungFuKick;
+    float rest[KICK_CHANNELS] = {}, lift[KICK_CHANNELS], swing[KICK_CHANNELS];
+    float swingHold[KICK_CHANNELS], back[KICK_CHANNELS], kick[KICK_CHANNELS];
+    setKickPose(lift, k.targetForward1, 0.0f, 0.0f, 0.40f);
+    setKickPose(swing, k.targetForward1 + k.swingForwardExtra, k.targetAbduction, pre, 0.70f);
+    setKickPose(swingHold, k.targetForward1, k.targetAbduction, pre, 0.60f);
+    setKickPose(back, k.targetBack, 0.0f, pre, 0.40f);
+    setKickPose(kick, k.targetForward2, k.targetAbduction, 1.0f, 1.00f);
+
+    float pose[KICK_CHANNELS];
+    if (t <= p1)      lerpN(rest, lift, smooth01(t / p1), pose, KICK_CHANNELS);
+    else if (t <= p2) lerpN(lift, swing, smooth01((t - p1) / (p2 - p1)), pose, KICK_CHANNELS);
+    else if (t <= p3) lerpN(swingHold, back, smooth01((t - p2) / (p3 - p2)), pose, KICK_CHANNELS);
+    else if (t <= p4) lerpN(back, kick, smooth01((t - p3) / (p4 - p3)), pose, KICK_CHANNELS);
+    else              std::copy(kick, kick + KICK_CHANNELS, pose); // hold
+    writeKickChannels(pose);
 }
 
 void drawRightLegLift() {
     // Intentionally empty; transforms are applied in the main character draw.
 }
 
-// Optional handy effect: a small textured cloud puff on the ground.
+// One cloud = a centre puff plus a fixed ring of six
+static const int kCloudPuffs = 7;
+
+static void buildKickCloud(Impostor* puffs, float x, float y, float z, float scale, float alpha) {
+    for (int i = 0; i < kCloudPuffs; ++i) {
+        const float a = 1.047f * i + 0.4f;
+        const float d = (i == 0) ? 0.0f : 0.28f * scale;
+        Impostor& p = puffs[i];
+        p.x = x + d * std::cos(a);
+        p.y = y + 0.12f * scale;
+        p.z = z + d * std::sin(a);
+        p.size = (i == 0 ? 0.30f : 0.22f) * scale;
+        p.spin = 2.3f * i;
+        p.a = alpha;
+    }
+}
+
+// Optional handy effect: a small cloud of soft puffs on the ground, one
+// impostor batch (camera-facing, one draw however many puffs).
 void drawKickCloudAt(float x, float y, float z, float scale, float alpha) {
-    glPushAttrib(GL_ENABLE_BIT | GL_TEXTURE_BIT | GL_CURRENT_BIT | GL_COLOR_BUFFER_BIT);
-    glDisable(GL_LIGHTING);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-    glEnable(GL_TEXTURE_2D);
-    glBindTexture(GL_TEXTURE_2D, gTex.cloud);
-    glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
-    glColor4f(1.0f, 1.0f, 1.0f, alpha);
-
-    glPushMatrix();
-    glTranslatef(x, y + 0.02f, z);
-    glScalef(scale, scale, scale);
-
-    const float r = 0.5f;
-    glBegin(GL_QUADS);
-    glNormal3f(0, 1, 0);
-    glTexCoord2f(0.0f, 0.0f); glVertex3f(-r, 0.0f, -r);
-    glTexCoord2f(1.0f, 0.0f); glVertex3f(r, 0.0f, -r);
-    glTexCoord2f(1.0f, 1.0f); glVertex3f(r, 0.0f, r);
-    glTexCoord2f(0.0f, 1.0f); glVertex3f(-r, 0.0f, r);
-    glEnd();
-
-    glPopMatrix();
-    glPopAttrib();
+    Impostor puffs[kCloudPuffs];
+    buildKickCloud(puffs, x, y, z, scale, alpha);
+    queueImpostors(puffs, kCloudPuffs, BLEND_ALPHA, gTex.cloud);
+}
+
+// Dust kicked up during the kick phase and hold: a trail of clouds around
+// the support foot that spreads and fades. Ground effect of the kick system.
+void drawKungFuKickDust(float x, float y, float z) {
+    if (!kungFuKick.isActive) return;
+    const KungFuKickState& k = kungFuKick;
+    const float kickStart = k.phase1Dur + k.phase2Dur + k.phase3Dur;
+    const float kickEnd = kickStart + k.phase4Dur + k.holdDur;
+    if (k.time < kickStart) return;
+
+    const float t = clamp01((k.time - kickStart) / (kickEnd - kickStart));
+    const int kClouds = 6;
+    Impostor puffs[kClouds * kCloudPuffs];
+    int n = 0;
+    for (int i = 0; i < kClouds; ++i) {
+        // clouds leave in turn along the swing, each growing as it fades
+        const float age = clamp01(t * 1.5f - 0.08f * i);
+        if (age <= 0.0f) continue;
+        const float a = 0.35f * i - 0.6f;
+        const float r = 0.35f + 0.5f * age;
+        buildKickCloud(puffs + n, x + r * std::sin(a), y, z + r * std::cos(a),
+                       0.6f + 0.9f * age, 0.55f * (1.0f - age));
+        n += kCloudPuffs;
+    }
+    queueImpostors(puffs, n, BLEND_ALPHA, gTex.cloud);   // the whole trail is one draw
 }
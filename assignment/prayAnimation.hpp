@@ -91,4 +91,8 @@ void updateRightStraightLegLift();
 
 // Kung Fu Kick controls
 void triggerKungFuKick();
-void updateKungFuKickAnimation();
\ No newline at end of file
+void updateKungFuKickAnimation();
+void drawKungFuKickDust(float x, float y, float z);   // ground effect while kicking
+
+// Soft cloud puffs on the ground (queued for the transparent pass)
+void drawKickCloudAt(float x, float y, float z, float scale, float alpha);
\ No newline at end of file
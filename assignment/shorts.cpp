@@ -3,6 +3,7 @@
 #include "utils.hpp"
 #include "model.hpp"
 #include "customization.hpp"   // getCurrentShirtTexture()
+#include "textureAtlas.hpp"
 #include <GL/freeglut.h>
 #include <cmath>
 
@@ -87,7 +88,7 @@ void drawShorts() {
     {
         glPushAttrib(GL_ENABLE_BIT | GL_TEXTURE_BIT | GL_CURRENT_BIT | GL_LIGHTING_BIT);
         glEnable(GL_TEXTURE_2D);
-        glBindTexture(GL_TEXTURE_2D, gTex.goldBelt);  // <- your gold belt texture
+        beginAtlasTexture(gTex.goldBelt);  // <- your gold belt texture
         glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
 
         glPushMatrix();
@@ -104,6 +105,7 @@ void drawShorts() {
         gluDeleteQuadric(qb);
         glPopMatrix();
 
+        endAtlasTexture();
         glBindTexture(GL_TEXTURE_2D, 0);
         glPopAttrib();
     }
@@ -153,7 +155,9 @@ void drawShorts() {
     drawUnitCubeTex(0.8f, 1.6f);
     glPopMatrix();
 
-    // Leg cuffs (silk cylinders)
+    // Leg cuffs (silk cylinders) and the bridge keep their UVs in [0,1]:
+    // they take the shirt's atlas tile
+    beginAtlasTexture(silkTex);
     const float cuffY = hemY - 0.02f;
     const float cuffH = 0.30f;
     const float cuffRTop = 0.31f;
@@ -188,6 +192,7 @@ void drawShorts() {
     drawUnitCubeTex(0.7f, 0.4f);
     glPopMatrix();
 
+    endAtlasTexture();
     glBindTexture(GL_TEXTURE_2D, 0);
     glPopAttrib();
 
@@ -0,0 +1,291 @@
+#include "textureAtlas.hpp"
+#include "utils.hpp"        // decodeTextureFile
+#include "bmpLoader.hpp"
+#include "jobPool.hpp"
+#include "assetPack.hpp"
+#include "mipCache.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+
+#ifndef GL_BGRA_EXT
+#define GL_BGRA_EXT 0x80E1
+#endif
+#ifndef GL_CLAMP_TO_EDGE
+#define GL_CLAMP_TO_EDGE 0x812F
+#endif
+#ifndef GL_TEXTURE_MAX_LEVEL
+#define GL_TEXTURE_MAX_LEVEL 0x813D
+#endif
+
+static const int kGutter = 16;        // texels of replicated edge round each tile
+static const int kLevels = 5;         // 16 -> 1 texel of gutter at the last level
+static const int kMinTile = kGutter;  // keeps every slot on a gutter boundary
+static const int kTileMaxSize = 512;  // character tiles are small on screen
+
+static int nextPow2(int v) {
+    int p = 1;
+    while (p < v) p <<= 1;
+    return p;
+}
+
+// Copy a tile into its slot and smear its edges out over the gutter
+static void blitTile(unsigned char* atlas, int atlasW, int x, int y,
+                     const unsigned char* tile, int tw, int th) {
+    const int slotW = tw + 2 * kGutter, slotH = th + 2 * kGutter;
+    for (int row = 0; row < th; ++row) {
+        unsigned char* d = atlas + ((size_t)(y + kGutter + row) * atlasW + x) * 4;
+        const unsigned char* s = tile + (size_t)row * tw * 4;
+        for (int i = 0; i < kGutter; ++i) std::memcpy(d + i * 4, s, 4);
+        std::memcpy(d + kGutter * 4, s, (size_t)tw * 4);
+        for (int i = 0; i < kGutter; ++i) std::memcpy(d + (kGutter + tw + i) * 4, s + (tw - 1) * 4, 4);
+    }
+    const unsigned char* first = atlas + ((size_t)(y + kGutter) * atlasW + x) * 4;
+    const unsigned char* last = atlas + ((size_t)(y + kGutter + th - 1) * atlasW + x) * 4;
+    for (int i = 0; i < kGutter; ++i) {
+        std::memcpy(atlas + ((size_t)(y + i) * atlasW + x) * 4, first, (size_t)slotW * 4);
+        std::memcpy(atlas + ((size_t)(y + slotH - 1 - i) * atlasW + x) * 4, last, (size_t)slotW * 4);
+    }
+}
+
+bool packTextureAtlas(const AtlasImage* images, int count, int tileMaxSize, int maxSize,
+                      MipChain& out, std::vector<AtlasRect>& rects) {
+    // tile sizes: the power of two GLU would pick, halved to fit
+    std::vector<int> tw(count), th(count), order(count);
+    for (int i = 0; i < count; ++i) {
+        int w = mipNearestPower(images[i].width), h = mipNearestPower(images[i].height);
+        while (w > tileMaxSize || h > tileMaxSize) {
+            if (w > 1) w >>= 1;
+            if (h > 1) h >>= 1;
+        }
+        tw[i] = std::max(w, kMinTile);
+        th[i] = std::max(h, kMinTile);
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return th[a] > th[b]; });
+
+    // shelf packing, tallest first; try every power-of-two width and keep
+    // the smallest (then squarest) atlas
+    int widest = 1;
+    for (int i = 0; i < count; ++i) widest = std::max(widest, tw[i] + 2 * kGutter);
+    int bestW = 0, bestH = 0;
+    std::vector<int> slotX(count), slotY(count), tryX(count), tryY(count);
+    for (int W = nextPow2(widest); W <= maxSize; W <<= 1) {
+        int x = 0, y = 0, shelf = 0;
+        for (int k = 0; k < count; ++k) {
+            const int i = order[k];
+            const int sw = tw[i] + 2 * kGutter, sh = th[i] + 2 * kGutter;
+            if (x + sw > W) { y += shelf; x = 0; shelf = 0; }
+            tryX[i] = x; tryY[i] = y;
+            x += sw;
+            shelf = std::max(shelf, sh);
+        }
+        const int H = nextPow2(y + shelf);
+        if (H > maxSize) continue;
+        const bool smaller = bestW == 0 || (long)W * H < (long)bestW * bestH ||
+            ((long)W * H == (long)bestW * bestH && std::abs(W - H) < std::abs(bestW - bestH));
+        if (smaller) { bestW = W; bestH = H; slotX = tryX; slotY = tryY; }
+    }
+    if (bestW == 0) return false;
+
+    std::vector<unsigned char> atlas((size_t)bestW * bestH * 4, 0);
+    std::vector<unsigned char> tile;
+    rects.resize(count);
+    for (int i = 0; i < count; ++i) {
+        const AtlasImage& img = images[i];
+        const unsigned char* src = img.bgra;
+        if (img.width != tw[i] || img.height != th[i]) {
+            tile.resize((size_t)tw[i] * th[i] * 4);
+            resampleBgra(img.bgra, img.width, img.height, tile.data(), tw[i], th[i]);
+            src = tile.data();
+        }
+        blitTile(atlas.data(), bestW, slotX[i], slotY[i], src, tw[i], th[i]);
+
+        AtlasRect& r = rects[i];
+        r.u0 = (float)(slotX[i] + kGutter) / bestW;
+        r.u1 = (float)(slotX[i] + kGutter + tw[i]) / bestW;
+        r.v0 = (float)(slotY[i] + kGutter) / bestH;
+        r.v1 = (float)(slotY[i] + kGutter + th[i]) / bestH;
+    }
+
+    // already power-of-two: this only halves; drop the levels past the gutter
+    buildMipChain(atlas.data(), bestW, bestH, maxSize, out);
+    if ((int)out.levels.size() > kLevels) {
+        out.texels.resize(out.levels[kLevels].offset);
+        out.levels.resize(kLevels);
+    }
+    return true;
+}
+
+// ---------- Character atlas ----------
+struct AtlasMember {
+    GLuint texture;
+    std::string path;
+    AtlasRect rect;
+};
+static std::vector<AtlasMember> gMembers;
+static GLuint gAtlasTex = 0;
+static bool gPending = false;          // GL thread only
+
+struct AtlasJob {
+    std::vector<std::string> paths;
+    int maxSize = 0;
+
+    // filled in by the worker
+    std::vector<std::vector<unsigned char> > images;
+    std::vector<int> widths, heights;
+    std::vector<bool> decoded;
+    bool packed = false;
+    MipChain chain;
+    std::vector<AtlasRect> rects;
+};
+static std::mutex gDoneMutex;
+static AtlasJob* gDone = nullptr;
+
+static bool packJob(AtlasJob* job) {
+    static const unsigned char kMissing[4] = { 200, 200, 200, 255 };
+    std::vector<AtlasImage> images(job->paths.size());
+    for (size_t i = 0; i < images.size(); ++i) {
+        if (job->decoded[i]) images[i] = AtlasImage{ job->images[i].data(), job->widths[i], job->heights[i] };
+        else images[i] = AtlasImage{ kMissing, 1, 1 };
+    }
+    return packTextureAtlas(images.data(), (int)images.size(), kTileMaxSize, job->maxSize, job->chain, job->rects);
+}
+
+static void atlasJob(void* user) {
+    AtlasJob* job = (AtlasJob*)user;
+    const size_t n = job->paths.size();
+    job->images.resize(n);
+    job->widths.assign(n, 0);
+    job->heights.assign(n, 0);
+    job->decoded.assign(n, false);
+
+    // every member is also a standalone streamed texture, so reuse the level
+    // 0 it already has in the pack or the mip cache; decode only as a last resort
+    bool all = true;
+    for (size_t i = 0; i < n; ++i) {
+        const std::string path = assetPath(job->paths[i].c_str());
+        PackedTexture packed;
+        CachedMipChain cached;
+        if (findPackedTexture(job->paths[i].c_str(), packed)) {
+            job->images[i].assign(packed.texels, packed.texels + (size_t)packed.width * packed.height * 4);
+            job->widths[i] = packed.width;
+            job->heights[i] = packed.height;
+            job->decoded[i] = true;
+        }
+        else if (openCachedMipChain(path.c_str(), job->maxSize, cached)) {
+            const MipLevel& l = cached.levels[0];
+            job->images[i].assign(cached.texels + l.offset, cached.texels + l.offset + (size_t)l.width * l.height * 4);
+            job->widths[i] = l.width;
+            job->heights[i] = l.height;
+            job->decoded[i] = true;
+            closeCachedMipChain(cached);
+        }
+        else job->decoded[i] = loadBmpFile(path.c_str(), job->images[i], job->widths[i], job->heights[i]);
+        all = all && job->decoded[i];
+    }
+    if (all) job->packed = packJob(job);   // otherwise the GL thread finishes it
+
+    std::lock_guard<std::mutex> lock(gDoneMutex);
+    gDone = job;
+}
+
+static void setSamplerState(int levels) {
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, levels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levels - 1);
+}
+
+void addToTextureAtlas(GLuint texture, const char* path) {
+    AtlasMember m;
+    m.texture = texture;
+    m.path = path;
+    m.rect = AtlasRect{ 0.0f, 0.0f, 1.0f, 1.0f };
+    gMembers.push_back(m);
+}
+
+void streamTextureAtlas() {
+    if (gMembers.empty() || gPending) return;
+
+    static const unsigned char kPlaceholder[4] = { 200, 200, 200, 255 };
+    if (!gAtlasTex) glGenTextures(1, &gAtlasTex);
+    glBindTexture(GL_TEXTURE_2D, gAtlasTex);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1, 1, 0, GL_BGRA_EXT, GL_UNSIGNED_BYTE, kPlaceholder);
+    setSamplerState(1);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    AtlasJob* job = new AtlasJob();
+    for (size_t i = 0; i < gMembers.size(); ++i) job->paths.push_back(gMembers[i].path);
+    GLint maxSize = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxSize);
+    job->maxSize = maxSize;
+    gPending = true;
+    submitBackgroundJob(atlasJob, job);
+}
+
+bool uploadTextureAtlas() {
+    if (!gPending) return false;
+    AtlasJob* job = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(gDoneMutex);
+        std::swap(job, gDone);
+    }
+    if (!job) return false;
+    gPending = false;
+
+    if (!job->packed) {
+        // files the portable decoder rejected: the full loader (GDI+ on Windows)
+        for (size_t i = 0; i < job->paths.size(); ++i) {
+            if (job->decoded[i]) continue;
+            job->decoded[i] = decodeTextureFile(assetPath(job->paths[i].c_str()).c_str(),
+                job->images[i], job->widths[i], job->heights[i]);
+            if (!job->decoded[i]) std::printf("Texture atlas: can't load %s (grey tile)\n", job->paths[i].c_str());
+        }
+        job->packed = packJob(job);
+    }
+    if (!job->packed) {
+        std::printf("Texture atlas: %d tiles don't fit in one texture (keeping the placeholder)\n",
+            (int)job->paths.size());
+        delete job;
+        return false;
+    }
+
+    glBindTexture(GL_TEXTURE_2D, gAtlasTex);
+    uploadMipChain(job->chain);
+    setSamplerState((int)job->chain.levels.size());
+    glBindTexture(GL_TEXTURE_2D, 0);
+    for (size_t i = 0; i < gMembers.size() && i < job->rects.size(); ++i) gMembers[i].rect = job->rects[i];
+
+    std::printf("Texture atlas: %d textures in %dx%d\n", (int)gMembers.size(),
+        job->chain.levels[0].width, job->chain.levels[0].height);
+    delete job;
+    return true;
+}
+
+bool textureAtlasPending() { return gPending; }
+
+void beginAtlasTexture(GLuint texture) {
+    glMatrixMode(GL_TEXTURE);
+    glPushMatrix();
+    const AtlasMember* m = nullptr;
+    for (size_t i = 0; i < gMembers.size() && !m; ++i)
+        if (texture && gMembers[i].texture == texture) m = &gMembers[i];
+    if (m) {
+        glBindTexture(GL_TEXTURE_2D, gAtlasTex);
+        glTranslatef(m->rect.u0, m->rect.v0, 0.0f);
+        glScalef(m->rect.u1 - m->rect.u0, m->rect.v1 - m->rect.v0, 1.0f);
+    }
+    else glBindTexture(GL_TEXTURE_2D, texture);
+    glMatrixMode(GL_MODELVIEW);
+}
+
+void endAtlasTexture() {
+    glMatrixMode(GL_TEXTURE);
+    glPopMatrix();
+    glMatrixMode(GL_MODELVIEW);
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <GL/freeglut.h>
+#include <vector>
+#include "mipChain.hpp"
+
+// ---------------- Texture atlas ----------------
+// Packs several images into one texture so draws that used to bind their
+// own texture can share a single binding. Every image gets a power-of-two
+// tile surrounded by a gutter of replicated edge texels, and tiles sit on
+// gutter-aligned slots; the mip chain stops at the level where the gutter
+// is one texel wide, so neither bilinear filtering nor the small levels
+// pull in a neighbour.
+//
+// A tile is selected through the texture matrix, which maps the usual
+// [0,1] coordinates (glTexCoord, GLU quadrics or texgen) into its
+// rectangle. Coordinates outside [0,1] run into the gutter and then the
+// next tile, so anything tiled with GL_REPEAT keeps its own texture.
+
+struct AtlasRect {
+    float u0, v0, u1, v1;     // tile interior in atlas texture coordinates
+};
+
+struct AtlasImage {
+    const unsigned char* bgra;   // top row first
+    int width, height;
+};
+
+// CPU half, safe on any thread: resample each image to a power-of-two tile
+// (at most tileMaxSize a side), pack them into the smallest power-of-two
+// atlas no larger than maxSize and build its mip chain. rects[i] is where
+// image i ended up. False when the tiles don't fit.
+bool packTextureAtlas(const AtlasImage* images, int count, int tileMaxSize, int maxSize,
+                      MipChain& out, std::vector<AtlasRect>& rects);
+
+// ---------- Character atlas ----------
+// Members are keyed by the GL name of their standalone texture (e.g. the
+// gTex entry streamTexture2D returned) plus the file it came from. Until
+// the packed atlas is uploaded it is a 1x1 placeholder with every tile
+// covering all of it, the same grey the streamed textures start with.
+
+void addToTextureAtlas(GLuint texture, const char* path);
+void streamTextureAtlas();           // decode and pack the members on the background jobs
+bool uploadTextureAtlas();           // GL thread, per frame: true when it was uploaded now
+bool textureAtlasPending();
+
+// Bind the atlas and select `texture`'s tile; a texture that isn't a member
+// is bound as it is. Always pair with endAtlasTexture (restores the
+// texture matrix; leaves the binding alone).
+void beginAtlasTexture(GLuint texture);
+void endAtlasTexture();
@@ -0,0 +1,241 @@
+#include "textureStreaming.hpp"
+#include "utils.hpp"        // decodeTextureFile
+#include "bmpLoader.hpp"
+#include "mipChain.hpp"
+#include "mipCache.hpp"
+#include "assetPack.hpp"
+#include "jobPool.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#ifndef GL_BGRA_EXT
+#define GL_BGRA_EXT 0x80E1
+#endif
+
+static const size_t kUploadBudgetBytes = 8u << 20;   // per frame
+
+struct StreamJob {
+    std::string path;
+    GLuint id = 0;
+    bool mipmaps = true;
+    int maxSize = 0;
+
+    // filled in by the worker
+    bool decoded = false;
+    int width = 0, height = 0;
+    std::vector<unsigned char> bgra;   // base image (no mipmaps)
+    MipChain chain;                    // mipmapped
+    bool cached = false;
+    CachedMipChain cache;              // mipmapped, mapped from disk
+    bool fromPack = false;
+    PackedTexture packed;              // mipmapped, inside the asset pack
+};
+
+// finished jobs, handed from the workers to the GL thread
+static std::mutex gDoneMutex;
+static std::condition_variable gDoneReady;
+static std::vector<StreamJob*> gDone;
+
+static int gPending = 0;               // GL thread only
+static int gStreamedTotal = 0;
+static std::chrono::steady_clock::time_point gFirstQueued;
+
+static void decodeJob(void* user) {
+    StreamJob* job = (StreamJob*)user;
+    if (job->mipmaps && openCachedMipChain(job->path.c_str(), job->maxSize, job->cache))
+        job->decoded = job->cached = true;
+    else {
+        job->decoded = loadBmpFile(job->path.c_str(), job->bgra, job->width, job->height);
+        if (job->decoded && job->mipmaps) {
+            buildMipChain(job->bgra.data(), job->width, job->height, job->maxSize, job->chain);
+            std::vector<unsigned char>().swap(job->bgra);
+            writeCachedMipChain(job->path.c_str(), job->maxSize, job->chain);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(gDoneMutex);
+    gDone.push_back(job);
+    gDoneReady.notify_one();
+}
+
+static void setSamplerState(bool mipmaps) {
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, mipmaps ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+}
+
+static GLuint createPlaceholder() {
+    // light grey, so modulated materials keep their own colour
+    static const unsigned char kPlaceholder[4] = { 200, 200, 200, 255 };
+    GLuint id = 0;
+    glGenTextures(1, &id);
+    glBindTexture(GL_TEXTURE_2D, id);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1, 1, 0, GL_BGRA_EXT, GL_UNSIGNED_BYTE, kPlaceholder);
+    setSamplerState(false);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    return id;
+}
+
+static void queueStream(GLuint id, const char* path, bool mipmaps) {
+    GLint maxSize = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxSize);
+
+    StreamJob* job = new StreamJob();
+    job->path = assetPath(path);
+    job->id = id;
+    job->mipmaps = mipmaps;
+    job->maxSize = maxSize;
+    if (gPending == 0) gFirstQueued = std::chrono::steady_clock::now();
+    ++gPending;
+    ++gStreamedTotal;
+
+    // in the asset pack: already decoded and mipmapped, straight to the upload queue
+    if (mipmaps && findPackedTexture(path, job->packed)) {
+        job->fromPack = job->decoded = true;
+        std::lock_guard<std::mutex> lock(gDoneMutex);
+        gDone.push_back(job);
+        return;
+    }
+    submitBackgroundJob(decodeJob, job);
+}
+
+GLuint streamTexture2D(const char* path, bool mipmaps) {
+    const GLuint id = createPlaceholder();
+    queueStream(id, path, mipmaps);
+    return id;
+}
+
+static size_t uploadJob(StreamJob* job) {
+    if (job->fromPack) {
+        glBindTexture(GL_TEXTURE_2D, job->id);
+        uploadPackedTexture(job->packed, job->maxSize);
+        setSamplerState(true);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        return job->packed.bytes;
+    }
+
+    // the portable decoder said no: try the full loader here (GDI+ on Windows)
+    if (!job->decoded) {
+        job->decoded = decodeTextureFile(job->path.c_str(), job->bgra, job->width, job->height);
+        if (job->decoded && job->mipmaps) {
+            buildMipChain(job->bgra.data(), job->width, job->height, job->maxSize, job->chain);
+            writeCachedMipChain(job->path.c_str(), job->maxSize, job->chain);
+        }
+    }
+    if (!job->decoded) {
+        std::printf("Texture: can't load %s (keeping the placeholder)\n", job->path.c_str());
+        return 0;
+    }
+
+    glBindTexture(GL_TEXTURE_2D, job->id);
+    if (job->cached) {
+        uploadCachedMipChain(job->cache);
+        const size_t bytes = job->cache.bytes;
+        closeCachedMipChain(job->cache);
+        setSamplerState(true);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        return bytes;
+    }
+    if (job->mipmaps) uploadMipChain(job->chain);
+    else {
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, job->width, job->height, 0,
+            GL_BGRA_EXT, GL_UNSIGNED_BYTE, job->bgra.data());
+    }
+    setSamplerState(job->mipmaps);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    return job->mipmaps ? job->chain.texels.size() : job->bgra.size();
+}
+
+static int uploadFinished(size_t budget) {
+    std::vector<StreamJob*> ready;
+    {
+        std::lock_guard<std::mutex> lock(gDoneMutex);
+        ready.swap(gDone);
+    }
+
+    int uploaded = 0;
+    size_t bytes = 0;
+    size_t i = 0;
+    for (; i < ready.size() && (uploaded == 0 || bytes < budget); ++i) {
+        bytes += uploadJob(ready[i]);
+        delete ready[i];
+        ++uploaded;
+    }
+    if (i < ready.size()) {   // over budget: the rest waits for the next frame
+        std::lock_guard<std::mutex> lock(gDoneMutex);
+        gDone.insert(gDone.begin(), ready.begin() + i, ready.end());
+    }
+
+    gPending -= uploaded;
+    if (uploaded && gPending == 0) {
+        const double ms = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - gFirstQueued).count();
+        std::printf("Textures: %d streamed in, all resident %.1f ms after the first request\n",
+            gStreamedTotal, ms);
+        gStreamedTotal = 0;
+    }
+    return uploaded;
+}
+
+int uploadStreamedTextures() {
+    if (gPending == 0) return 0;
+    return uploadFinished(kUploadBudgetBytes);
+}
+
+int pendingStreamedTextures() { return gPending; }
+
+void finishStreamedTextures() {
+    while (gPending > 0) {
+        {
+            std::unique_lock<std::mutex> lock(gDoneMutex);
+            gDoneReady.wait(lock, [] { return !gDone.empty(); });
+        }
+        uploadFinished((size_t)-1);
+    }
+}
+
+// ---------- Lazy textures ----------
+struct LazyTexture {
+    GLuint id;
+    std::string path;
+    bool mipmaps;
+    bool queued;
+};
+static std::vector<LazyTexture> gLazy;
+
+GLuint lazyTexture2D(const char* path, bool mipmaps) {
+    LazyTexture t;
+    t.id = createPlaceholder();
+    t.path = path;
+    t.mipmaps = mipmaps;
+    t.queued = false;
+    gLazy.push_back(t);
+    return t.id;
+}
+
+static void queueLazy(GLuint texture, const char* why) {
+    if (!texture) return;
+    for (size_t i = 0; i < gLazy.size(); ++i) {
+        LazyTexture& t = gLazy[i];
+        if (t.id != texture) continue;
+        if (!t.queued) {
+            t.queued = true;
+            std::printf("Texture: loading %s (%s)\n", t.path.c_str(), why);
+            queueStream(t.id, t.path.c_str(), t.mipmaps);
+        }
+        return;
+    }
+}
+
+void prefetchTexture(GLuint texture) { queueLazy(texture, "prefetch"); }
+
+GLuint useTexture(GLuint texture) {
+    queueLazy(texture, "first use");
+    return texture;
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include <GL/freeglut.h>
+
+// ---------------- Streamed texture loading ----------------
+// streamTexture2D hands back a valid texture name at once, bound to a 1x1
+// neutral placeholder, and queues the file on the background jobs
+// (jobPool.hpp): decode and mip-chain generation run there, in parallel.
+// Only the GL uploads stay on the GL thread: uploadStreamedTextures(),
+// called at the top of each frame, swaps finished images into their
+// names in place, so every copy of the handle sees the real texture.
+// Files the portable decoder rejects are decoded on the GL thread instead.
+
+GLuint streamTexture2D(const char* path, bool mipmaps = true);
+
+// GL thread, once per frame: upload what has finished (up to a per-frame
+// byte budget, always at least one). Returns the number uploaded.
+int  uploadStreamedTextures();
+int  pendingStreamedTextures();     // queued and not yet uploaded
+void finishStreamedTextures();      // block until everything is uploaded
+
+// ---------- Lazy textures ----------
+// For textures only some animations draw: lazyTexture2D hands out a name
+// bound to the same placeholder but reads nothing. The file is queued the
+// first time the texture is drawn (useTexture) or earlier, when an
+// animation trigger prefetches it, and then streams in like any other.
+// Until then the texture costs one 1x1 image.
+
+GLuint lazyTexture2D(const char* path, bool mipmaps = true);
+void   prefetchTexture(GLuint texture);  // queue it now; no-op once queued or if not lazy
+GLuint useTexture(GLuint texture);       // draw-time: queue on first use, returns `texture`
@@ -2,6 +2,7 @@
 #include "torso.hpp"
 #include "utils.hpp"
 #include "model.hpp"
+#include "textureAtlas.hpp"
 #include <GL/freeglut.h>
 #include <cmath>
 
@@ -9,25 +10,27 @@
 // gShirtTex is defined in customization.cpp. We just reference it here.
 extern GLuint gShirtTex;   // 0 means "no specific pick" -> fall back to a default
 
+// Selected shirt texture, or gold belt until the user picks one via H/G
+static inline GLuint torsoShirtTexture() {
+    return gShirtTex ? gShirtTex : gTex.goldBelt;
+}
+
 // Bind currently selected shirt texture (state is pushed/popped safely)
-static inline void beginShirtMaterial() {
+static inline void beginTorsoShirtMaterial() {
     glPushAttrib(GL_ENABLE_BIT | GL_TEXTURE_BIT | GL_CURRENT_BIT | GL_LIGHTING_BIT);
 
     glEnable(GL_TEXTURE_2D);
     glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
     glColor3f(1, 1, 1);
 
-    // If user hasn't picked via H/G yet, fall back to a sensible default.
-    // You already load these in main.cpp: gTex.redSilk, gTex.goldBelt, etc.
-    GLuint tex = gShirtTex ? gShirtTex : gTex.goldBelt;
-    glBindTexture(GL_TEXTURE_2D, tex);
+    glBindTexture(GL_TEXTURE_2D, torsoShirtTexture());
 
     // Nice tiling behavior
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
 }
 
-static inline void endShirtMaterial() {
+static inline void endTorsoShirtMaterial() {
     glBindTexture(GL_TEXTURE_2D, 0);
     glPopAttrib();
 }
@@ -363,7 +366,7 @@ static void drawVestTopYoke(float yawDeg) {
     glRotatef(yawDeg, 0, 1, 0);
 
     // --- Texture on the red vest sections ---
-    beginShirtMaterial();
+    beginTorsoShirtMaterial();
     float startRed1 = endB + EPS_ANG;
     float sweepRed1 = fmaxf(0.0f, (360.0f - startRed1) - (startB - EPS_ANG));
     if (sweepRed1 > 0.0f) drawRingArcY_Tex(yTop, rIn, rOut, startRed1, sweepRed1, 96, /*uRepeat*/2.0f);
@@ -371,7 +374,7 @@ static void drawVestTopYoke(float yawDeg) {
     float startRed2 = 0.0f;
     float sweepRed2 = fmaxf(0.0f, (startB - EPS_ANG) - startRed2);
     if (sweepRed2 > 0.0f) drawRingArcY_Tex(yTop, rIn, rOut, startRed2, sweepRed2, 96, /*uRepeat*/2.0f);
-    endShirtMaterial();
+    endTorsoShirtMaterial();
 
     // --- Black belly section stays matte ---
     glPushAttrib(GL_ENABLE_BIT | GL_POLYGON_BIT | GL_DEPTH_BUFFER_BIT);
@@ -391,7 +394,7 @@ static void drawVestTopYoke(float yawDeg) {
 // Textured vest side panels (replaces glut cube with UV cube)
 // -----------------------------------------------------------------------------
 static void drawSidePanels() {
-    beginShirtMaterial();
+    beginTorsoShirtMaterial();
 
     glPushMatrix();
     glTranslatef(-0.42f, 0.0f, 0.05f);
@@ -407,7 +410,7 @@ static void drawSidePanels() {
     drawTexturedUnitCube(/*u*/1.2f, /*v*/1.2f);
     glPopMatrix();
 
-    endShirtMaterial();
+    endTorsoShirtMaterial();
 }
 
 // -----------------------------------------------------------------------------
@@ -417,7 +420,8 @@ static void drawWaistSeal() {
     GLboolean wasCull = glIsEnabled(GL_CULL_FACE);
     if (wasCull) glDisable(GL_CULL_FACE);
 
-    beginShirtMaterial();
+    beginTorsoShirtMaterial();
+    beginAtlasTexture(torsoShirtTexture());   // quadric UVs stay in [0,1]
     glPushMatrix();
     glTranslatef(0.0f, -0.690f, 0.0f);
     glRotatef(-90, 1, 0, 0);
@@ -443,7 +447,8 @@ static void drawWaistSeal() {
 
     gluDeleteQuadric(q);
     glPopMatrix();
-    endShirtMaterial();
+    endAtlasTexture();
+    endTorsoShirtMaterial();
 
     if (wasCull) glEnable(GL_CULL_FACE);
 }
@@ -460,7 +465,7 @@ void drawTorso() {
     const float yawDeg = -8.0f;
 
     // --- Main vest shell (textured open cylinder) ---
-    beginShirtMaterial();
+    beginTorsoShirtMaterial();
     glPushMatrix();
     glRotatef(yawDeg, 0, 1, 0);
     // slight tiling around the body so the pattern repeats nicely
@@ -468,7 +473,7 @@ void drawTorso() {
         edgeL, 360.0f - VEST_GAP_DEG, 64,
         /*uRepeat*/3.0f, /*vRepeat*/1.0f);
     glPopMatrix();
-    endShirtMaterial();
+    endTorsoShirtMaterial();
 
     // Panda body underneath (no texture)
     drawPandaTorsoCore();
@@ -479,13 +484,13 @@ void drawTorso() {
     drawSidePanels();        // textured cubes
 
     // Waist band (textured cube)
-    beginShirtMaterial();
+    beginTorsoShirtMaterial();
     glPushMatrix();
     glTranslatef(0.0f, -0.675f, 0.0f);
     glScalef(1.12f, 0.20f, 0.54f);
     drawTexturedUnitCube(/*u*/2.0f, /*v*/0.5f);
     glPopMatrix();
-    endShirtMaterial();
+    endTorsoShirtMaterial();
 
     // Decorative elements that should stay non-textured
     const float yCollar = MS.torsoH * 0.5f - 0.012f;
@@ -0,0 +1,96 @@
+#include "transparentPass.hpp"
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+static std::vector<TransparentItem> gItems;
+static std::vector<uint32_t> gKeys, gOrder, gKeysTmp, gOrderTmp;
+static int gLastFrameItems = 0;
+static int gFrame = 0;
+
+TransparentItem& queueTransparent(float ax, float ay, float az, TransparentBlend blend,
+                                  GLuint texture, TransparentDrawFn draw) {
+    gItems.emplace_back();
+    TransparentItem& item = gItems.back();
+    glGetFloatv(GL_MODELVIEW_MATRIX, item.modelview);
+    const GLfloat* m = item.modelview;
+    // eye-space z of the anchor; the camera looks down -z
+    item.depth = -(m[2] * ax + m[6] * ay + m[10] * az + m[14]);
+    item.blend = blend;
+    item.texture = texture;
+    item.draw = draw;
+    item.data = nullptr;
+    item.args[0] = item.args[1] = item.args[2] = item.args[3] = 0.0f;
+    return item;
+}
+
+// Float -> unsigned key with the same ordering, inverted so that an
+// ascending sort yields the farthest item first.
+static uint32_t farFirstKey(float depth) {
+    uint32_t bits;
+    std::memcpy(&bits, &depth, sizeof(bits));
+    bits = (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+    return ~bits;
+}
+
+// LSD radix sort of (key, index) pairs, 8 bits per pass; stable, so items
+// at equal depth keep their queue order.
+static void radixSortItems() {
+    const size_t n = gItems.size();
+    gKeys.resize(n); gOrder.resize(n); gKeysTmp.resize(n); gOrderTmp.resize(n);
+    for (size_t i = 0; i < n; ++i) { gKeys[i] = farFirstKey(gItems[i].depth); gOrder[i] = (uint32_t)i; }
+
+    for (int shift = 0; shift < 32; shift += 8) {
+        size_t count[257] = {};
+        for (size_t i = 0; i < n; ++i) ++count[((gKeys[i] >> shift) & 0xFF) + 1];
+        for (int b = 0; b < 256; ++b) count[b + 1] += count[b];
+        for (size_t i = 0; i < n; ++i) {
+            const size_t dst = count[(gKeys[i] >> shift) & 0xFF]++;
+            gKeysTmp[dst] = gKeys[i];
+            gOrderTmp[dst] = gOrder[i];
+        }
+        gKeys.swap(gKeysTmp);
+        gOrder.swap(gOrderTmp);
+    }
+}
+
+void flushTransparentPass() {
+    ++gFrame;
+    gLastFrameItems = (int)gItems.size();
+    if (gItems.empty()) return;
+    radixSortItems();
+
+    glPushAttrib(GL_ENABLE_BIT | GL_CURRENT_BIT | GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_TEXTURE_BIT);
+    glDisable(GL_LIGHTING);
+    glEnable(GL_BLEND);
+    glDepthMask(GL_FALSE);
+    glDepthFunc(GL_LEQUAL);   // overlays on already-drawn surfaces pass
+    glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+
+    glMatrixMode(GL_MODELVIEW);
+    glPushMatrix();
+
+    int blend = -1;
+    GLuint texture = (GLuint)-1;
+    for (uint32_t index : gOrder) {
+        const TransparentItem& item = gItems[index];
+        if ((int)item.blend != blend) {
+            blend = item.blend;
+            glBlendFunc(GL_SRC_ALPHA, blend == BLEND_ADDITIVE ? GL_ONE : GL_ONE_MINUS_SRC_ALPHA);
+        }
+        if (item.texture != texture) {
+            if (item.texture) { glEnable(GL_TEXTURE_2D); glBindTexture(GL_TEXTURE_2D, item.texture); }
+            else if (texture != 0) glDisable(GL_TEXTURE_2D);
+            texture = item.texture;
+        }
+        glLoadMatrixf(item.modelview);
+        item.draw(item);
+    }
+
+    glPopMatrix();
+    glPopAttrib();
+    gItems.clear();
+}
+
+int transparentItemsLastFrame() { return gLastFrameItems; }
+int transparentPassFrame() { return gFrame; }
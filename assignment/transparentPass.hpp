@@ -0,0 +1,42 @@
+#pragma once
+#include <GL/freeglut.h>
+
+// ---------------- Transparent pass ----------------
+// Blended geometry is queued while the opaque scene is drawn and drawn once
+// at the end, back to front. Queueing captures the current modelview and the
+// view depth of an anchor point, so items can be queued from anywhere in the
+// hierarchy. The flush radix-sorts by depth and sets the shared state
+// (blend on, depth writes off, lighting off, texture modulate, LEQUAL) a
+// single time; between items only the blend mode and texture change, and
+// only when they differ from the previous item.
+//
+// Draw callbacks run with the item's modelview loaded and must not change
+// that shared state (colour, client arrays and their own matrix pushes are fine).
+
+enum TransparentBlend {
+    BLEND_ALPHA = 0,     // src alpha, one minus src alpha
+    BLEND_ADDITIVE       // src alpha, one
+};
+
+struct TransparentItem;
+typedef void (*TransparentDrawFn)(const TransparentItem& item);
+
+struct TransparentItem {
+    GLfloat modelview[16];
+    float depth;                 // distance along the view axis (bigger = farther)
+    TransparentBlend blend;
+    GLuint texture;              // 0 = untextured
+    TransparentDrawFn draw;
+    const void* data;            // caller-owned, must outlive the frame
+    float args[4];               // small per-item parameters
+};
+
+// Queue `draw` at the anchor (ax, ay, az) in the current modelview space.
+// Returns the item so callers can fill data/args.
+TransparentItem& queueTransparent(float ax, float ay, float az, TransparentBlend blend,
+                                  GLuint texture, TransparentDrawFn draw);
+
+// Sort and draw everything queued this frame, then empty the queue.
+void flushTransparentPass();
+int  transparentItemsLastFrame();  // drawn by the last flush (shown with the 'P' stats)
+int  transparentPassFrame();    // bumped by each flush (per-frame storage can key on it)
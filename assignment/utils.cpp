@@ -1,9 +1,15 @@
 ﻿// utils.cpp
 #include "utils.hpp"
 #include "customization.hpp"   // for RGB & gOutfitColor
+#include "bmpLoader.hpp"
+#include "mipChain.hpp"
+#include "mipCache.hpp"
+#include "assetPack.hpp"
 #include <cmath>
 #include <cstdio>
+#include <cstring>
 #include <string>              // for multibyte→wide conversion
+#include <vector>
 
 // ---------------- Palette values ----------------
 const float Palette::SKIN[3] = { 1.00f, 0.85f, 0.75f };
@@ -479,25 +485,33 @@ void countGLUCone() {
     PrimitiveCounter::addPrimitive(GLPrimitive::GLU_CONE_PRIM);
 }
 
-// ---------------- Texture support (GDI+ loader, MULTIBYTE API) ----------------
+// ---------------- Texture support ----------------
+// BMPs are decoded by the portable loader (bmpLoader.hpp) straight from a
+// memory-mapped file. On Windows, GDI+ stays behind it for anything that
+// loader rejects (other formats, compressed BMPs); elsewhere the GDI+
+// start/stop calls are no-ops.
+Textures gTex;                 // global texture handles
+
+#ifndef GL_BGRA_EXT
+#define GL_BGRA_EXT 0x80E1
+#endif
+
+#if defined(_WIN32)
 // IMPORTANT: include order fixes GDI+ compile errors (IStream/PROPID etc.)
+#ifndef NOMINMAX
 #define NOMINMAX
+#endif
 #include <Windows.h>
 #include <objidl.h>
 #include <gdiplus.h>
 #pragma comment(lib, "gdiplus.lib")
 using namespace Gdiplus;
 
-Textures gTex;                 // global texture handles
 static ULONG_PTR gTok = 0;
 
 void startGDIplus() { GdiplusStartupInput in; GdiplusStartup(&gTok, &in, nullptr); }
 void stopGDIplus() { if (gTok) { GdiplusShutdown(gTok); gTok = 0; } }
 
-#ifndef GL_BGRA_EXT
-#define GL_BGRA_EXT 0x80E1
-#endif
-
 // Convert multibyte (UTF-8 preferred; fallback to system ANSI) to wide
 static std::wstring mbToWide(const char* s) {
     if (!s) return L"";
@@ -514,37 +528,77 @@ static std::wstring mbToWide(const char* s) {
     return w;
 }
 
-// Uses GLU to build mipmaps → no need for glGenerateMipmap (keeps compatibility with opengl32.dll)
-GLuint loadTexture2D(const char* path, bool mipmaps) {
+// Fallback decode through GDI+ into the same BGRA, top-row-first layout
+static bool decodeWithGDIplus(const char* path, std::vector<unsigned char>& bgra, int& w, int& h) {
+    if (!gTok) return false;
     std::wstring wpath = mbToWide(path);
-    if (wpath.empty()) return 0;
+    if (wpath.empty()) return false;
 
     Bitmap bmp(wpath.c_str());
-    if (bmp.GetLastStatus() != Ok) return 0;
+    if (bmp.GetLastStatus() != Ok) return false;
 
     Rect r(0, 0, bmp.GetWidth(), bmp.GetHeight());
     BitmapData bd{};
-    bmp.LockBits(&r, ImageLockModeRead, PixelFormat32bppARGB, &bd);
+    if (bmp.LockBits(&r, ImageLockModeRead, PixelFormat32bppARGB, &bd) != Ok) return false;
+    w = (int)bd.Width; h = (int)bd.Height;
+    bgra.resize((size_t)w * h * 4);
+    for (int y = 0; y < h; ++y)
+        std::memcpy(&bgra[(size_t)y * w * 4], (const unsigned char*)bd.Scan0 + (ptrdiff_t)y * bd.Stride, (size_t)w * 4);
+    bmp.UnlockBits(&bd);
+    return true;
+}
+#else
+void startGDIplus() {}
+void stopGDIplus() {}
+static bool decodeWithGDIplus(const char*, std::vector<unsigned char>&, int&, int&) { return false; }
+#endif
+
+bool decodeTextureFile(const char* path, std::vector<unsigned char>& bgra, int& w, int& h) {
+    return loadBmpFile(path, bgra, w, h) || decodeWithGDIplus(path, bgra, w, h);
+}
+
+// Mipmaps are built on the CPU the way gluBuild2DMipmaps builds them
+// (mipChain.hpp), so the streamed and synchronous paths give identical levels,
+// and are kept in the on-disk cache (mipCache.hpp) for the next start.
+GLuint loadTexture2D(const char* path, bool mipmaps) {
+    static std::vector<unsigned char> upload;   // reused: one buffer for every load
+    static MipChain chain;
+    GLint maxSize = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxSize);
+
+    PackedTexture packed;
+    const bool fromPack = mipmaps && findPackedTexture(path, packed);
+    const std::string file = assetPath(path);
+    CachedMipChain cached;
+    const bool fromCache = mipmaps && !fromPack && openCachedMipChain(file.c_str(), maxSize, cached);
+    int w = 0, h = 0;
+    if (!fromPack && !fromCache && !decodeTextureFile(file.c_str(), upload, w, h)) {
+        std::printf("Texture: can't load %s\n", path);
+        return 0;
+    }
 
     GLuint id = 0; glGenTextures(1, &id);
     glBindTexture(GL_TEXTURE_2D, id);
     glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
 
-    if (mipmaps) {
-        gluBuild2DMipmaps(GL_TEXTURE_2D, GL_RGBA8, bd.Width, bd.Height,
-            GL_BGRA_EXT, GL_UNSIGNED_BYTE, bd.Scan0);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    if (fromPack) uploadPackedTexture(packed, maxSize);
+    else if (fromCache) {
+        uploadCachedMipChain(cached);
+        closeCachedMipChain(cached);
+    }
+    else if (mipmaps) {
+        buildMipChain(upload.data(), w, h, maxSize, chain);
+        uploadMipChain(chain);
+        writeCachedMipChain(file.c_str(), maxSize, chain);
     }
     else {
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, bd.Width, bd.Height, 0,
-            GL_BGRA_EXT, GL_UNSIGNED_BYTE, bd.Scan0);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, w, h, 0,
+            GL_BGRA_EXT, GL_UNSIGNED_BYTE, upload.data());
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     }
 
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-
-    bmp.UnlockBits(&bd);
     return id;
 }
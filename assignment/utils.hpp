@@ -1,6 +1,7 @@
 #pragma once
 #include <GL/freeglut.h>
 #include <cmath>
+#include <vector>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -199,3 +200,7 @@ void endShirtMaterial();
 void startGDIplus();
 void stopGDIplus();
 GLuint loadTexture2D(const char* path, bool mipmaps = true);
+
+// Decode an image file to BGRA, top row first (portable BMP decoder, then
+// GDI+ on Windows). Used by the loaders above and the texture streamer.
+bool decodeTextureFile(const char* path, std::vector<unsigned char>& bgra, int& width, int& height);